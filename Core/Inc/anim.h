@@ -0,0 +1,35 @@
+#ifndef ANIM_H_
+#define ANIM_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 界面动画：擦除过渡、反显闪烁、等待转圈。软件定时器（SysTick）每ANIM_TICK_MS
+// 在中断中只累加节拍，绘制在主循环anim_poll中进行：每次只画到期的最新一帧，
+// 主循环被模块数据等处理耽误时跳过中间帧，动画不补画、不阻塞
+#define ANIM_TICK_MS 40U            // 节拍周期（25帧/秒）
+#define ANIM_FRAME_BUDGET_US 2000U  // 单帧绘制预算，超出时跳过下一帧
+#define ANIM_WIPE_FRAMES 6U         // 擦除过渡帧数（约240ms）
+#define ANIM_BLINK_FRAMES 5U        // 闪烁每次反显/恢复保持的帧数（200ms）
+#define ANIM_SPINNER_FRAMES 2U      // 转圈每步保持的帧数（80ms）
+
+// 动画统计
+typedef struct {
+  uint32_t drawn;       // 已绘制帧数
+  uint32_t skipped;     // 跳过的帧数（主循环来不及或上一帧超出预算）
+  uint32_t over_budget; // 绘制超出ANIM_FRAME_BUDGET_US的帧数
+  uint32_t draw_us_max; // 单帧最大绘制耗时
+} anim_stats_t;
+
+extern volatile anim_stats_t anim_stats;
+
+// 函数声明
+void anim_wipe(void);
+void anim_blink(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t count);
+void anim_blink_stop(void);
+void anim_spinner(uint8_t x, uint8_t y);
+void anim_stop(void);
+void anim_poll(void);
+bool anim_busy(void);
+
+#endif /* ANIM_H_ */
@@ -0,0 +1,32 @@
+#ifndef DWT_H_
+#define DWT_H_
+
+#include "stm32f1xx_hal.h"
+
+// DWT周期计数器：72MHz下每个计数为1/72微秒，约59.6秒回绕一次
+#define DWT_CYCLES_PER_US (SystemCoreClock / 1000000U)
+
+/**
+ * @brief 使能DWT周期计数器（用于时延测量，重复调用无副作用）
+ */
+static inline void dwt_init(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief 读取当前CPU周期计数
+ * @return uint32_t 周期计数（差值运算可自动处理回绕）
+ */
+static inline uint32_t dwt_cycles(void) { return DWT->CYCCNT; }
+
+/**
+ * @brief 周期数换算为微秒
+ * @param cycles 周期数
+ * @return uint32_t 微秒数（向下取整）
+ */
+static inline uint32_t dwt_cycles_to_us(uint32_t cycles) {
+  return cycles / DWT_CYCLES_PER_US;
+}
+
+#endif /* DWT_H_ */
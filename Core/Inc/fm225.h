@@ -25,6 +25,29 @@
 #define CMD_RESET_FACE 0x10  // 终止操作命令
 #define CMD_DELETE_USER 0x20 // 删除指定用户命令
 
+// 消息类型定义（帧内第3字节）
+#define MID_REPLY 0x00 // 命令应答消息
+#define MID_NOTE 0x01  // 模块主动上报消息
+
+// 上报消息类型（帧内第6字节）
+#define NID_READY 0x00      // 模块上电就绪
+#define NID_FACE_STATE 0x01 // 人脸状态
+
+// 人脸状态（NID_FACE_STATE消息第7字节）
+#define FACE_STATE_NORMAL 0x00 // 人脸正常
+#define FACE_STATE_NOFACE 0x01 // 未检测到人脸
+
+// 应答结果（应答帧第7字节）
+#define MR_SUCCESS 0x00              // 成功
+#define MR_FAILED_TIMEOUT 0x0D       // 操作超时
+#define MR_FAILED_FACE_ENROLLED 0x0A // 人脸已录入
+
+// 验证成功快速通道：串口中断到开锁输出的时延预算（微秒）
+#define FM225_FAST_BUDGET_US 10
+
+// 用户名长度（录入命令与验证应答中固定32字节，不足补0）
+#define FM225_NAME_LEN 32
+
 #define RX_BUFF_SIZE 128
 #define TX_BUFF_SIZE 64
 
@@ -35,6 +58,21 @@ extern uint8_t user_buffer_len;
 
 extern UART_HandleTypeDef huart1;
 
+// 验证成功快速通道统计
+typedef struct {
+  uint32_t count;           // 快速通道触发次数
+  uint32_t latency_us_last; // 最近一次串口中断到开锁输出的时延
+  uint32_t latency_us_max;  // 最大时延
+  uint32_t over_budget;     // 超出FM225_FAST_BUDGET_US的次数
+} fm225_fast_stats_t;
+
+extern volatile uint32_t fm225_rx_cycles;
+extern volatile bool fm225_verify_armed;
+extern volatile fm225_fast_stats_t fm225_fast_stats;
+extern volatile bool fm225_verified;
+extern volatile uint16_t fm225_verified_id;
+extern char fm225_verified_name[FM225_NAME_LEN + 1];
+
 // 函数声明
 bool verify_received_data(const uint8_t *recv_data, uint16_t data_len);
 bool face_enroll(uint8_t admin, const uint8_t user_name[32],
@@ -44,5 +82,7 @@ bool face_delete_all();
 bool face_verify(uint8_t pd_rightaway, uint8_t timeout);
 bool face_reset();
 bool face_delete_user(uint16_t id);
+bool fm225_fast_path(const uint8_t *frame, uint16_t len);
+void fm225_verify_success_callback(uint16_t user_id);
 
 #endif /* FM225_H_ */
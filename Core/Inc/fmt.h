@@ -0,0 +1,21 @@
+#ifndef FMT_H_
+#define FMT_H_
+
+#include <stdint.h>
+
+// 无堆、无浮点的整数格式化，替代显示路径中的sprintf
+// 所有函数写入dst并以'\0'结尾，返回指向结尾'\0'的指针，便于连续拼接：
+//   p = fmt_u32(buf, year, 4, '0', 10); *p++ = '-'; p = fmt_u32(p, mon, 2, '0', 10);
+// width为最小宽度（不足时左侧补pad），调用者保证dst足够大：
+// fmt_u32最多32位数字（base=2），fmt_i32/fmt_fixed最多12个字符，另加width与'\0'
+
+#define FMT_U32_DIGITS 32 // base=2时的最大位数
+
+// 函数声明
+char *fmt_u32(char *dst, uint32_t value, uint8_t width, char pad, uint8_t base);
+char *fmt_i32(char *dst, int32_t value, uint8_t width, char pad);
+char *fmt_fixed(char *dst, int32_t value, uint8_t decimals, uint8_t width,
+                char pad);
+char *fmt_str(char *dst, const char *src);
+
+#endif /* FMT_H_ */
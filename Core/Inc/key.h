@@ -0,0 +1,44 @@
+#ifndef KEY_H_
+#define KEY_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 按键编号（同时作为位掩码的位序号）
+#define KEY_0 0
+#define KEY_1 1
+#define KEY_2 2
+#define KEY_3 3
+#define KEY_NUM 4
+#define KEY_MASK(key) (1U << (key))
+
+// 扫描参数（TIM1周期5ms）
+#define KEY_SCAN_PERIOD_MS 5U      // 扫描周期
+#define KEY_LONG_PRESS_MS 800U     // 长按判定时间
+#define KEY_REPEAT_START_MS 300U   // 首次连发间隔
+#define KEY_REPEAT_MIN_MS 50U      // 最小连发间隔
+#define KEY_REPEAT_ACCEL_SHIFT 3U  // 每次连发间隔缩短1/8
+
+// 按键事件类型
+typedef enum {
+  KEY_EVENT_PRESS = 0, // 按下（消抖后）
+  KEY_EVENT_RELEASE,   // 释放（消抖后）
+  KEY_EVENT_LONG,      // 长按（按住超过KEY_LONG_PRESS_MS，触发一次）
+  KEY_EVENT_REPEAT,    // 连发（长按后按逐渐缩短的间隔重复触发）
+} key_event_type_t;
+
+// 按键事件
+typedef struct {
+  uint8_t key;           // 按键编号（KEY_0~KEY_3）
+  key_event_type_t type; // 事件类型
+  uint32_t tick;         // 事件时间戳（HAL_GetTick，毫秒）
+} key_event_t;
+
+// 函数声明
+void key_exti_callback(uint16_t GPIO_Pin);
+void key_scan_tick(void);
+void key_set_repeat_mask(uint8_t mask);
+uint8_t key_state(void);
+void key_event_callback(const key_event_t *event);
+
+#endif /* KEY_H_ */
@@ -0,0 +1,20 @@
+#ifndef LANG_H_
+#define LANG_H_
+
+#include "screens.h"
+#include "strtab.h"
+
+// 界面语言：文字与预渲染界面按语言各有一张表（构建时由assets/strings.txt、screens.txt生成），
+// 字形表（F8X16、font_cjk）各语言共用。切换语言只换当前表指针，
+// 取文字、界面都是一次数组下标访问，绘制时没有额外开销
+extern const char *const *lang_str_table;
+extern const oled_screen_t *const *lang_scr_table;
+
+#define STR(id) (lang_str_table[(id)])    // 当前语言的文字（UTF-8，str_id_t）
+#define SCREEN(id) (lang_scr_table[(id)]) // 当前语言的预渲染界面（scr_id_t）
+
+// 函数声明
+void lang_set(lang_t lang);
+lang_t lang_get(void);
+
+#endif /* LANG_H_ */
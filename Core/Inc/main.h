@@ -53,6 +53,7 @@ extern "C" {
 void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
+void SystemClock_Config(void);
 
 /* USER CODE END EFP */
 
@@ -71,6 +72,8 @@ void Error_Handler(void);
 #define IO4_GPIO_Port GPIOA
 #define IO3_Pin GPIO_PIN_0
 #define IO3_GPIO_Port GPIOB
+#define LOCK_Pin GPIO_PIN_1
+#define LOCK_GPIO_Port GPIOB
 #define KEY3_Pin GPIO_PIN_12
 #define KEY3_GPIO_Port GPIOB
 #define KEY3_EXTI_IRQn EXTI15_10_IRQn
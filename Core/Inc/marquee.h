@@ -0,0 +1,22 @@
+#ifndef MARQUEE_H_
+#define MARQUEE_H_
+
+#include "oled.h"
+#include <stdbool.h>
+
+// 跑马灯：超过一行宽度的文字由面板按页范围硬件滚动，滚动过程不占用MCU与I2C，
+// 只在每滚完一圈时换下一段文字
+#define MARQUEE_TEXT_MAX 32   // 最长文字字节数（与FM225用户名长度一致）
+#define MARQUEE_GAP 16        // 每段文字后至少保留的空白（像素），区分首尾
+#define MARQUEE_INTERVAL 0x07 // 面板滚动间隔：每步2帧（见OLED_ScrollStart）
+// 每步耗时估算：帧率 = Fosc(约370kHz) / (D5分频1 × D9周期(1+15+50) × 64行) ≈ 88Hz
+#define MARQUEE_STEP_MS 23U
+#define MARQUEE_LAP_MS (MARQUEE_STEP_MS * OLED_WIDTH) // 滚动一圈，画面回到起点
+
+// 函数声明
+void marquee_start(uint8_t page, const char *text, uint16_t len);
+void marquee_stop(void);
+void marquee_poll(void);
+bool marquee_busy(void);
+
+#endif /* MARQUEE_H_ */
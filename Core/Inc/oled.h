@@ -3,28 +3,89 @@
 
 #include "stm32f1xx_hal.h"
 #include "oledfont.h"
+#include <stdbool.h>
+#include <string.h>
 extern I2C_HandleTypeDef  hi2c1;
 
+#define OLED_WIDTH 128 // 列数
+#define OLED_PAGES 8   // 页数（每页8行像素）
+
+// 绘图方式（OLED_FillRect、OLED_Blit等）
+#define OLED_CLEAR 0 // 清除像素
+#define OLED_SET 1   // 点亮像素
+#define OLED_XOR 2   // 像素取反（反显区域）
+#define OLED_COPY 3  // 位图原样覆盖（OLED_Blit；填充类函数中同OLED_SET）
+
+// 文字对齐方式（OLED_DrawText）
+#define OLED_ALIGN_LEFT 0   // 锚点为文字左端
+#define OLED_ALIGN_CENTER 1 // 锚点为文字中点
+#define OLED_ALIGN_RIGHT 2  // 锚点为文字右端
+
+// 绘制与刷新测试统计（发送队列的深度与排空耗时见oled_queue_stats）
+typedef struct {
+  uint32_t full_legacy_us; // 整屏刷新耗时：逐页定位+逐字节写入（OLED_BenchFullRefresh）
+  uint32_t full_stream_us; // 整屏刷新耗时：单窗口连续写入（OLED_BenchFullRefresh）
+  uint32_t decode_bytes;   // 解码输出字节数（OLED_BenchDecode）
+  uint32_t decode_us;      // 解码耗时（OLED_BenchDecode）
+  uint32_t text_cycles_max; // 单条文字绘制最大耗时（DWT周期，OLED_BenchText）
+  uint32_t frame_count;     // OLED_Refresh提交的帧数
+  uint32_t frame_deferred;  // 上一帧未发完、推迟提交的次数
+} oled_stats_t;
+
+extern volatile oled_stats_t oled_stats;
+
+// 预渲染界面（tools/gen_screens.py由assets/screens.txt生成，见screens.h）
+typedef struct {
+  uint8_t first_page;  // 覆盖的起始页
+  uint8_t last_page;   // 覆盖的结束页
+  uint16_t rle_size;   // 游程编码数据字节数（逐行编码，见rle.h），0表示未压缩
+  const uint8_t *data; // 未压缩时为(last_page-first_page+1)行×OLED_WIDTH字节，与显存布局相同
+} oled_screen_t;
+
 void OLED_WR_CMD(uint8_t cmd);
 void OLED_WR_DATA(uint8_t data);
+bool OLED_WR_CMDS(const uint8_t *cmds, uint16_t len);
+void OLED_WR_DATAS(const uint8_t *data, uint16_t len);
 void OLED_Init(void);
+void OLED_Invalidate(void);
+void OLED_Refresh(void);
+void OLED_RefreshLimit(uint8_t x1);
+void OLED_ReadGram(uint8_t page, uint8_t x0, uint8_t len, uint8_t *dst);
+bool OLED_Busy(void);
+void OLED_BenchFullRefresh(void);
 void OLED_Clear(void);
 void OLED_ClearRows(uint8_t start_page, uint8_t end_page);
-void OLED_Display_On(void);
-void OLED_Display_Off(void);
-void OLED_Set_Pos(uint8_t x, uint8_t y);
+void OLED_ShowScreen(const oled_screen_t *scr);
+void OLED_BenchDecode(const oled_screen_t *const *scrs, uint8_t count);
+bool OLED_Display_On(void);
+bool OLED_Display_Off(void);
+bool OLED_Set_Pos(uint8_t x, uint8_t y);
 void OLED_On(void);
 void OLED_ShowNum(uint8_t x,uint8_t y,unsigned int num,uint8_t len,uint8_t size2,uint8_t Color_Turn);
-void OLED_Showdecimal(uint8_t x,uint8_t y,float num,uint8_t z_len,uint8_t f_len,uint8_t size2, uint8_t Color_Turn);
+void OLED_Showdecimal(uint8_t x,uint8_t y,int32_t num,uint8_t z_len,uint8_t f_len,uint8_t size2, uint8_t Color_Turn);
 void OLED_ShowChar(uint8_t x,uint8_t y,uint8_t chr,uint8_t Char_Size,uint8_t Color_Turn);
 void OLED_ShowString(uint8_t x,uint8_t y,char*chr,uint8_t Char_Size,uint8_t Color_Turn);
-void OLED_ShowCHinese(uint8_t x,uint8_t y,uint8_t no,uint8_t Color_Turn);
+void OLED_ShowCHinese(uint8_t x,uint8_t y,uint16_t code,uint8_t Color_Turn);
+void OLED_ShowText(uint8_t x,uint8_t y,const char *str,uint8_t Color_Turn);
+uint16_t OLED_TextWidth(const char *str);
+uint16_t OLED_TextFit(const char *str, uint16_t max_width);
+uint16_t OLED_DrawText(int16_t x, int16_t y, const char *str, uint8_t align, uint8_t mode);
+uint16_t OLED_DrawText2X(int16_t x, int16_t y, const char *str, uint8_t align, uint8_t mode);
+void OLED_BenchText(const char *const *strs, uint8_t count);
 void OLED_DrawBMP(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t *  BMP,uint8_t Color_Turn);
-void OLED_HorizontalShift(uint8_t direction);
-void OLED_Some_HorizontalShift(uint8_t direction,uint8_t start,uint8_t end);
-void OLED_VerticalAndHorizontalShift(uint8_t direction);
-void OLED_DisplayMode(uint8_t mode);
-void OLED_IntensityControl(uint8_t intensity);
+void OLED_FillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t mode);
+void OLED_HLine(uint8_t x0, uint8_t x1, uint8_t y, uint8_t mode);
+void OLED_VLine(uint8_t x, uint8_t y0, uint8_t y1, uint8_t mode);
+void OLED_Rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t mode);
+void OLED_Blit(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bmp, uint8_t mode);
+bool OLED_ScrollStart(uint8_t direction, uint8_t start, uint8_t end, uint8_t interval);
+bool OLED_ScrollStop(void);
+bool OLED_Scrolling(void);
+bool OLED_HorizontalShift(uint8_t direction);
+bool OLED_Some_HorizontalShift(uint8_t direction,uint8_t start,uint8_t end);
+bool OLED_VerticalAndHorizontalShift(uint8_t direction);
+bool OLED_DisplayMode(uint8_t mode);
+bool OLED_IntensityControl(uint8_t intensity);
 
 
 
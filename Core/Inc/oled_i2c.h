@@ -0,0 +1,49 @@
+#ifndef OLED_I2C_H_
+#define OLED_I2C_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+#define OLED_I2C_ADDR 0x78      // SSD1306从机地址（8位写地址）
+#define OLED_CTRL_CMD 0x00      // 控制字节：后续均为命令
+#define OLED_CTRL_DATA 0x40     // 控制字节：后续均为显存数据
+#define OLED_I2C_TIMEOUT_MS 50U // 传输超时（1KB在400kHz下约23ms），DMA传输由oled_i2c_poll检查
+#define OLED_I2C_BACKOFF_MS 200U     // 故障后暂停发送的时间，连续故障时逐次加倍
+#define OLED_I2C_BACKOFF_MAX_MS 3200U // 暂停时间上限（面板不在时约3秒试一次）
+#define OLED_I2C_IDLE_WAIT_US 50U    // 启动前等待上次STOP完成、BUSY清零的时间
+#define OLED_I2C_RECOVER_HALF_US 5U  // 总线恢复时手动时钟的半周期（约100kHz）
+
+// I2C1引脚（重映射到PB8/PB9，见i2c.c），总线恢复时临时切换为开漏输出
+#define OLED_I2C_GPIO_Port GPIOB
+#define OLED_I2C_SCL_Pin GPIO_PIN_8
+#define OLED_I2C_SDA_Pin GPIO_PIN_9
+
+// 故障类型：低位与HAL_I2C_ERROR_*一致，另加启动前总线忙
+#define OLED_I2C_FAULT_BUSY 0x100U
+
+// 总线故障统计
+typedef struct {
+  uint32_t nack;      // 从机无应答（面板不在或受干扰）
+  uint32_t arlo;      // 仲裁丢失
+  uint32_t bus_error; // 总线错误（错位的START/STOP）
+  uint32_t bus_busy;  // 启动前总线一直忙（SDA/SCL被拉低或BUSY位锁死）
+  uint32_t timeout;   // 传输超时或HAL报告的其他错误（DMA、溢出）
+  uint32_t recover;   // 执行总线恢复的次数
+  uint32_t skipped;   // 暂停发送期间直接放弃的传输
+} oled_i2c_stats_t;
+
+extern volatile oled_i2c_stats_t oled_i2c_stats;
+
+// DMA传输完成回调（I2C中断上下文），ok=false表示传输出错
+typedef void (*oled_i2c_cb_t)(bool ok, void *arg);
+
+// 函数声明
+bool oled_i2c_write(uint8_t ctrl, const uint8_t *buf, uint16_t len);
+bool oled_i2c_write_dma(const uint8_t *buf, uint16_t len, oled_i2c_cb_t cb,
+                        void *arg);
+bool oled_i2c_busy(void);
+bool oled_i2c_wait_idle(void);
+bool oled_i2c_backoff(void);
+void oled_i2c_poll(void);
+
+#endif /* OLED_I2C_H_ */
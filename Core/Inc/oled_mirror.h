@@ -0,0 +1,36 @@
+#ifndef OLED_MIRROR_H_
+#define OLED_MIRROR_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 编译开关：面板镜像，把写入面板的改动经USART3（与跟踪记录共用）发给主机端
+// tools/oled_mirror.py重建显示；定义为0时OLED_MIRROR()调用点编译为空
+#ifndef OLED_MIRROR_ENABLE
+#define OLED_MIRROR_ENABLE 0
+#endif
+
+// 串口输出帧（每帧一段改动）：同步字2 + 序号1 + 页1 + 起始列1 + 长度1 + 显存数据N + BCC1
+#define OLED_MIRROR_SYNC0 0x4F // 'O'
+#define OLED_MIRROR_SYNC1 0x4D // 'M'
+
+// 镜像统计
+typedef struct {
+  uint32_t packets; // 已发送帧数
+  uint32_t bytes;   // 已发送显存数据字节数
+} oled_mirror_stats_t;
+
+#if OLED_MIRROR_ENABLE
+#define OLED_MIRROR(p0, p1, x0, x1) oled_mirror_mark((p0), (p1), (x0), (x1))
+#else
+#define OLED_MIRROR(p0, p1, x0, x1) ((void)0)
+#endif
+
+extern volatile oled_mirror_stats_t oled_mirror_stats;
+
+// 函数声明
+void oled_mirror_mark(uint8_t p0, uint8_t p1, uint8_t x0, uint8_t x1);
+void oled_mirror_drain(void);
+bool oled_mirror_busy(void);
+
+#endif /* OLED_MIRROR_H_ */
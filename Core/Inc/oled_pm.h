@@ -0,0 +1,27 @@
+#ifndef OLED_PM_H_
+#define OLED_PM_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 无操作计时按RTC秒计数（Stop模式下RTC继续运行，计时不受休眠影响）
+#define OLED_PM_DIM_S 15U     // 无操作多少秒后调暗
+#define OLED_PM_OFF_S 60U     // 无操作多少秒后关屏
+#define OLED_PM_BRIGHT 0xFFU  // 正常亮度
+#define OLED_PM_DIMMED 0x10U  // 调暗后的亮度
+
+typedef enum {
+  OLED_PM_ON = 0, // 正常亮度
+  OLED_PM_DIM,    // 已调暗
+  OLED_PM_OFF,    // 已关屏（GDDRAM内容保持）
+} oled_pm_state_t;
+
+// 函数声明
+void oled_pm_init(void);
+void oled_pm_activity(void);
+void oled_pm_poll(void);
+bool oled_pm_busy(void);
+uint32_t oled_pm_deadline(void);
+oled_pm_state_t oled_pm_state(void);
+
+#endif /* OLED_PM_H_ */
@@ -0,0 +1,44 @@
+#ifndef OLED_QUEUE_H_
+#define OLED_QUEUE_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 显示操作队列：主循环追加命令与数据段，由DMA逐条发送，主循环不等待传输。
+// 每条操作的控制字节与数据连续存放，DMA完成中断直接启动下一条；
+// 标记（oled_queue_fence）的回调由主循环oled_queue_poll执行
+#define OLED_QUEUE_OPS 32      // 操作环深度（2的幂）
+#define OLED_QUEUE_ARENA 1280  // 数据区字节数（整屏1024字节加控制字节与余量）
+#define OLED_QUEUE_INLINE 12   // 不超过此长度的命令直接存在操作中（不含控制字节）
+
+// 标记回调（oled_queue_fence）
+typedef void (*oled_queue_fence_cb_t)(void *arg);
+
+// 队列统计
+typedef struct {
+  uint32_t ops_max;          // 同时排队的最大操作数
+  uint32_t bytes_max;        // 数据区最大占用（字节）
+  uint32_t full_count;       // 队列或数据区已满被拒绝的次数
+  uint32_t error_count;      // 传输出错或无法启动的操作数
+  uint32_t drain_count;      // 排空次数（从开始发送到队列为空算一次）
+  uint32_t drain_bytes_last; // 最近一次排空发送的字节数
+  uint32_t drain_us_last;    // 最近一次排空耗时
+  uint32_t drain_us_max;     // 最大排空耗时
+} oled_queue_stats_t;
+
+extern volatile oled_queue_stats_t oled_queue_stats;
+
+// 函数声明
+bool oled_queue_write(uint8_t ctrl, const uint8_t *buf, uint16_t len);
+uint8_t *oled_queue_reserve(uint16_t len);
+void oled_queue_commit(uint8_t ctrl);
+bool oled_queue_fence(oled_queue_fence_cb_t cb, void *arg);
+bool oled_queue_room(uint8_t ops);
+bool oled_queue_room_arena(uint8_t runs, uint16_t bytes);
+void oled_queue_poll(void);
+void oled_queue_flush(void);
+bool oled_queue_idle(void);
+bool oled_queue_failed(void);
+bool oled_queue_take_error(void);
+
+#endif /* OLED_QUEUE_H_ */
@@ -3,7 +3,7 @@
 
 extern const unsigned char F6x8[][6];
 extern const unsigned char F8X16[];
-extern const unsigned char Hzk[][32];
+#define OLED_F8X16_COUNT 94 // F8X16字符数（从' '开始，每字符16字节）
 extern unsigned char BMP1[];
 //extern unsigned char BMP2[].........
 #endif /* OLED_OLEDFONT_H_ */
@@ -0,0 +1,33 @@
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 唤醒源定义（按位组合，可能同时存在多个）
+#define POWER_WAKE_NONE 0x00 // 未知唤醒源
+#define POWER_WAKE_KEY 0x01  // 按键外部中断
+#define POWER_WAKE_RTC 0x02  // RTC闹钟（EXTI17）
+#define POWER_WAKE_UART 0x04 // USART1 RX下降沿（EXTI7）
+
+// USART1 RX引脚（PB7）在Stop期间复用为EXTI7唤醒线
+#define POWER_UART_WAKE_Pin GPIO_PIN_7
+
+// 低功耗统计信息
+typedef struct {
+  uint32_t stop_count;       // 进入Stop模式的次数
+  uint32_t wake_us_last;     // 最近一次唤醒到就绪的耗时（微秒）
+  uint32_t wake_us_max;      // 唤醒到就绪的最大耗时（微秒）
+  uint8_t wake_source;       // 最近一次唤醒源（POWER_WAKE_*）
+} power_stats_t;
+
+extern volatile power_stats_t power_stats;
+
+// 函数声明
+void power_init(void);
+void power_idle(void);
+bool power_can_sleep(void);
+bool power_app_is_idle(void);
+uint32_t power_app_wakeup(uint32_t counter);
+
+#endif /* POWER_H_ */
@@ -0,0 +1,15 @@
+#ifndef PROGRESS_H_
+#define PROGRESS_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 倒计时进度条：占一页（8行），外框+内部填充，剩余时间越少填充越短；
+// 剩余时间按截止时刻（HAL_GetTick）计算，与调用者的超时定时器一致
+
+// 函数声明
+void progress_start(uint8_t page, uint32_t deadline, uint32_t duration_ms);
+void progress_stop(void);
+void progress_poll(void);
+
+#endif /* PROGRESS_H_ */
@@ -0,0 +1,16 @@
+#ifndef RLE_H_
+#define RLE_H_
+
+#include <stdint.h>
+
+// 显示资源的游程编码（tools/gen_screens.py --rle生成），按字节流编码，
+// 每个字节为一列纵向8个像素，与显存布局相同。控制字节c：
+//   c < 0x80   其后(c + 1)个字节原样复制
+//   c >= 0x80  其后1个字节重复((c & 0x7F) + 1)次
+#define RLE_RUN_FLAG 0x80
+#define RLE_MAX_COUNT 128
+
+// 函数声明
+uint16_t rle_decode(const uint8_t *src, uint8_t *dst, uint16_t dst_len);
+
+#endif /* RLE_H_ */
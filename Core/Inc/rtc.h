@@ -44,6 +44,8 @@ void MX_RTC_Init(void);
 void rtc_init_user(void);
 void RTC_GetTime(void);
 void RTC_SetTime(uint16_t *time_info);
+uint32_t RTC_GetCounter(void);
+void RTC_SetAlarm(uint32_t alarm_counter);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
@@ -0,0 +1,32 @@
+#ifndef SWTIMER_H_
+#define SWTIMER_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 时间轮槽数（2的幂），SysTick每1ms推进一个槽
+#define SWTIMER_WHEEL_BITS 6
+#define SWTIMER_WHEEL_SIZE (1U << SWTIMER_WHEEL_BITS)
+#define SWTIMER_WHEEL_MASK (SWTIMER_WHEEL_SIZE - 1U)
+
+typedef void (*swtimer_cb_t)(void *arg);
+
+// 软件定时器（由调用者分配，静态或全局对象，不使用堆）
+typedef struct swtimer {
+  struct swtimer *next; // 槽内双向循环链表
+  struct swtimer *prev;
+  uint32_t rounds;      // 剩余整圈数
+  swtimer_cb_t cb;      // 到期回调（SysTick中断上下文）
+  void *arg;            // 回调参数
+  bool active;          // 是否在时间轮中
+} swtimer_t;
+
+// 函数声明
+void swtimer_init(void);
+void swtimer_start(swtimer_t *timer, uint32_t ms, swtimer_cb_t cb, void *arg);
+void swtimer_stop(swtimer_t *timer);
+bool swtimer_active(const swtimer_t *timer);
+uint32_t swtimer_pending(void);
+void swtimer_tick(void);
+
+#endif /* SWTIMER_H_ */
@@ -0,0 +1,61 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "stm32f1xx_hal.h"
+#include <stdbool.h>
+
+// 编译开关：定义为0时所有TRACE()调用点编译为空，不占用代码与RAM
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+
+// 环形缓冲区记录数（2的幂）
+#define TRACE_RING_BITS 6
+#define TRACE_RING_SIZE (1U << TRACE_RING_BITS)
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1U)
+
+// 串口输出帧：同步字2 + 记录数1 + 丢失数1 + 记录16*N + BCC1
+#define TRACE_SYNC0 0x54 // 'T'
+#define TRACE_SYNC1 0x52 // 'R'
+#define TRACE_PACKET_MAX 16 // 每帧最多记录数
+
+// 事件ID（与tools/trace_decode.py中的名称表保持一致）
+typedef enum {
+  TRACE_EV_BOOT = 0x01, // 启动完成
+  TRACE_EV_STOP,        // 进入Stop：arg0=累计次数
+  TRACE_EV_WAKE,        // Stop唤醒：arg0=唤醒源，arg1=时钟恢复耗时(us)
+  TRACE_EV_KEY,         // 按键事件：arg0=按键，arg1=事件类型
+  TRACE_EV_UART_RX,     // FM225数据帧：arg0=长度，arg1=消息类型<<8|命令/消息ID
+  TRACE_EV_FAST_PATH,   // 验证成功开锁：arg0=用户ID，arg1=时延(us)
+  TRACE_EV_UI_STATE,    // 界面状态切换：arg0=新状态，arg1=当前操作
+  TRACE_EV_SWTIMER,     // 软件定时器到期：arg0=回调地址，arg1=回调参数
+  TRACE_EV_OLED_DRAIN,  // OLED显示队列排空：arg0=发送字节数，arg1=开始发送到排空耗时(us)
+  TRACE_EV_OLED_BENCH,  // 整屏刷新对比：arg0=逐字节写入(us)，arg1=单窗口写入(us)
+  TRACE_EV_RLE_BENCH,   // 界面解码速度：arg0=输出字节数，arg1=耗时(us)
+  TRACE_EV_OLED_PM,     // 面板亮度状态：arg0=oled_pm_state_t，arg1=无操作秒数
+  TRACE_EV_TEXT_BENCH,  // 文字绘制耗时：arg0=宽度(像素)，arg1=DWT周期
+  TRACE_EV_I2C_FAULT,   // 显示总线故障：arg0=HAL_I2C_ERROR_*|OLED_I2C_FAULT_BUSY，arg1=累计恢复次数
+} trace_event_t;
+
+// 跟踪记录（16字节，小端，主机端按同样布局解析）
+typedef struct {
+  uint32_t cycles; // DWT周期计数
+  uint16_t id;     // 事件ID
+  uint8_t ctx;     // 记录时的异常号（IPSR），0=主循环
+  uint8_t seq;     // 写入序号+1的低8位，最后写入，作为记录完成标记
+  uint32_t arg0;
+  uint32_t arg1;
+} trace_record_t;
+
+#if TRACE_ENABLE
+#define TRACE(id, a0, a1) trace_record((id), (uint32_t)(a0), (uint32_t)(a1))
+#else
+#define TRACE(id, a0, a1) ((void)0)
+#endif
+
+// 函数声明
+void trace_record(uint16_t id, uint32_t arg0, uint32_t arg1);
+void trace_drain(void);
+bool trace_busy(void);
+
+#endif /* TRACE_H_ */
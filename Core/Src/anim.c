@@ -0,0 +1,226 @@
+#include "anim.h"
+#include "dwt.h"
+#include "oled.h"
+#include "swtimer.h"
+
+#define SPINNER_SIZE 8U  // 转圈图案宽高（像素）
+#define SPINNER_STEPS 8U // 转一圈的步数
+
+volatile anim_stats_t anim_stats = {0};
+
+// 转圈图案：圆周上8个位置顺时针，头部两点为2x2、尾部一点为单像素（按页排列，低位在上）
+static const uint8_t s_spinner[SPINNER_STEPS][SPINNER_SIZE] = {
+    {0x00, 0x0E, 0x06, 0x03, 0x03, 0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x04, 0x03, 0x03, 0x06, 0x06, 0x00},
+    {0x00, 0x00, 0x00, 0x02, 0x00, 0x06, 0x1E, 0x18},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x78, 0x18},
+    {0x00, 0x00, 0x00, 0xC0, 0xC0, 0x60, 0x68, 0x00},
+    {0x00, 0x60, 0x60, 0xC0, 0xC0, 0x20, 0x00, 0x00},
+    {0x18, 0x78, 0x60, 0x40, 0x00, 0x00, 0x00, 0x00},
+    {0x18, 0x1E, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00},
+};
+
+static swtimer_t s_tick_timer;
+static volatile uint32_t s_ticks = 0;   // 节拍计数（SysTick中断累加）
+static volatile bool s_running = false; // 有动画进行中，节拍定时器持续运行
+static uint32_t s_frame = 0;            // 最近处理的节拍
+static bool s_skip_next = false;        // 上一帧超出预算，跳过下一帧
+
+// 擦除过渡
+static bool s_wipe = false;
+static uint32_t s_wipe_start = 0;
+// 反显闪烁：区域、剩余反显次数（0表示未进行）、当前是否反显
+static uint8_t s_blink_x0, s_blink_y0, s_blink_x1, s_blink_y1;
+static uint8_t s_blink_count = 0;
+static bool s_blink_inv = false;
+static uint32_t s_blink_start = 0;
+// 转圈：左上角坐标、当前步（SPINNER_STEPS表示未显示）
+static uint8_t s_spin_x, s_spin_y;
+static uint8_t s_spin_step = SPINNER_STEPS;
+static uint32_t s_spin_start = 0;
+
+static void anim_tick_cb(void *arg) {
+  (void)arg;
+  s_ticks++;
+  if (s_running) {
+    swtimer_start(&s_tick_timer, ANIM_TICK_MS, anim_tick_cb, NULL);
+  }
+}
+
+/**
+ * @brief 有动画开始时启动节拍定时器
+ */
+static void anim_run(void) {
+  if (!s_running) {
+    s_running = true;
+    s_frame = s_ticks;
+    s_skip_next = false;
+    swtimer_start(&s_tick_timer, ANIM_TICK_MS, anim_tick_cb, NULL);
+  }
+}
+
+/**
+ * @brief 所有动画结束后停止节拍定时器（不再唤醒主循环，不妨碍进入Stop）
+ */
+static void anim_idle(void) {
+  if (!s_wipe && s_blink_count == 0 && s_spin_step == SPINNER_STEPS) {
+    s_running = false;
+    swtimer_stop(&s_tick_timer);
+  }
+}
+
+/**
+ * @brief 擦除过渡第n帧：放开刷新范围到对应列，最后一帧不再限制
+ */
+static void wipe_draw(uint32_t n) {
+  if (n + 1U >= ANIM_WIPE_FRAMES) {
+    s_wipe = false;
+    OLED_RefreshLimit(OLED_WIDTH - 1);
+    return;
+  }
+  OLED_RefreshLimit((uint8_t)((n + 1U) * OLED_WIDTH / ANIM_WIPE_FRAMES - 1U));
+}
+
+/**
+ * @brief 闪烁第n帧：按阶段反显或恢复，共count次，结束时保持原样
+ */
+static void blink_draw(uint32_t n) {
+  uint32_t phase = n / ANIM_BLINK_FRAMES;
+  bool inv = phase < s_blink_count * 2U && (phase & 1U) == 0;
+
+  if (inv != s_blink_inv) {
+    OLED_FillRect(s_blink_x0, s_blink_y0, s_blink_x1, s_blink_y1, OLED_XOR);
+    s_blink_inv = inv;
+  }
+  if (phase >= s_blink_count * 2U) {
+    s_blink_count = 0;
+  }
+}
+
+/**
+ * @brief 转圈第n帧：换到对应的一步（图案不变时显存不变，不产生刷新）
+ */
+static void spinner_draw(uint32_t n) {
+  s_spin_step = (uint8_t)((n / ANIM_SPINNER_FRAMES) % SPINNER_STEPS);
+  OLED_Blit(s_spin_x, s_spin_y, SPINNER_SIZE, SPINNER_SIZE, s_spinner[s_spin_step],
+            OLED_COPY);
+}
+
+/**
+ * @brief 擦除过渡：本轮已画入显存的新界面在之后约ANIM_WIPE_FRAMES帧内从左向右显示
+ * @note  在切换界面的绘制之后、OLED_Refresh之前调用；过渡期间的改动同样逐步显示
+ */
+void anim_wipe(void) {
+  s_wipe = true;
+  s_wipe_start = s_ticks;
+  wipe_draw(0);
+  anim_run();
+}
+
+/**
+ * @brief 区域反显闪烁count次（立即开始反显），结束后恢复原样
+ * @param x0,y0 左上角（像素）
+ * @param x1,y1 右下角（像素，含）
+ * @param count 闪烁次数
+ */
+void anim_blink(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t count) {
+  anim_blink_stop();
+  if (count == 0) {
+    return;
+  }
+  s_blink_x0 = x0;
+  s_blink_y0 = y0;
+  s_blink_x1 = x1;
+  s_blink_y1 = y1;
+  s_blink_count = count;
+  s_blink_start = s_ticks;
+  blink_draw(0);
+  anim_run();
+}
+
+/**
+ * @brief 停止闪烁，区域恢复原样（用于需要独占面板刷新的内容，如跑马灯）
+ */
+void anim_blink_stop(void) {
+  if (s_blink_inv) {
+    OLED_FillRect(s_blink_x0, s_blink_y0, s_blink_x1, s_blink_y1, OLED_XOR);
+    s_blink_inv = false;
+  }
+  s_blink_count = 0;
+}
+
+/**
+ * @brief 在(x, y)显示8x8转圈图案，直到anim_stop
+ */
+void anim_spinner(uint8_t x, uint8_t y) {
+  s_spin_x = x;
+  s_spin_y = y;
+  s_spin_start = s_ticks;
+  spinner_draw(0);
+  anim_run();
+}
+
+/**
+ * @brief 停止全部动画：擦除过渡直接显示完整界面，闪烁区域恢复，转圈图案清除
+ */
+void anim_stop(void) {
+  if (s_wipe) {
+    s_wipe = false;
+    OLED_RefreshLimit(OLED_WIDTH - 1);
+  }
+  anim_blink_stop();
+  if (s_spin_step != SPINNER_STEPS) {
+    OLED_FillRect(s_spin_x, s_spin_y, s_spin_x + SPINNER_SIZE - 1,
+                  s_spin_y + SPINNER_SIZE - 1, OLED_CLEAR);
+    s_spin_step = SPINNER_STEPS;
+  }
+  anim_idle();
+}
+
+/**
+ * @brief 主循环调用（在OLED_Refresh之前）：有新节拍时绘制最新一帧
+ * @note  中间错过的节拍直接跳过（各动画按节拍数计算当前帧，不逐帧补画）；
+ *        一帧绘制超出ANIM_FRAME_BUDGET_US时跳过下一帧，把时间让给主循环的其他处理
+ */
+void anim_poll(void) {
+  uint32_t now = s_ticks;
+  uint32_t t0, us;
+
+  if (!s_running || now == s_frame) {
+    return;
+  }
+  anim_stats.skipped += now - s_frame - 1U;
+  s_frame = now;
+  if (s_skip_next) {
+    s_skip_next = false;
+    anim_stats.skipped++;
+    return;
+  }
+
+  t0 = dwt_cycles();
+  if (s_wipe) {
+    wipe_draw(now - s_wipe_start);
+  }
+  if (s_blink_count != 0) {
+    blink_draw(now - s_blink_start);
+  }
+  if (s_spin_step != SPINNER_STEPS) {
+    spinner_draw(now - s_spin_start);
+  }
+  us = dwt_cycles_to_us(dwt_cycles() - t0);
+
+  anim_stats.drawn++;
+  if (us > anim_stats.draw_us_max) {
+    anim_stats.draw_us_max = us;
+  }
+  if (us > ANIM_FRAME_BUDGET_US) {
+    anim_stats.over_budget++;
+    s_skip_next = true;
+  }
+  anim_idle();
+}
+
+/**
+ * @brief 是否有动画进行中
+ */
+bool anim_busy(void) { return s_running; }
@@ -1,5 +1,7 @@
 
 #include "fm225.h"
+#include "dwt.h"
+#include "trace.h"
 
 // 帧头常量定义
 static const uint8_t FRAME_HEADER[2] = {0xEF, 0xAA};
@@ -9,6 +11,13 @@ uint8_t RX_BUFFER[RX_BUFF_SIZE] = {0};   // 接收缓冲区
 uint8_t user_buffer[RX_BUFF_SIZE] = {0}; // 用户数据缓冲区
 uint8_t user_buffer_len = 0;             // 用户数据长度
 
+volatile uint32_t fm225_rx_cycles = 0;              // 串口/接收DMA中断入口时间戳
+volatile bool fm225_verify_armed = false;           // 验证命令已发出、尚未收到应答
+volatile fm225_fast_stats_t fm225_fast_stats = {0}; // 快速通道统计
+volatile bool fm225_verified = false;               // 验证成功待主循环处理
+volatile uint16_t fm225_verified_id = 0;            // 验证成功的用户ID
+char fm225_verified_name[FM225_NAME_LEN + 1] = {0};  // 验证成功的用户名（'\0'结尾）
+
 // 全局常量：合法的人脸录入方向列表（用于参数合法性校验，避免无效值传入）
 const uint8_t VALID_FACE_DIRS[] = {
     FACE_DIRECTION_UP,    FACE_DIRECTION_DOWN,   FACE_DIRECTION_LEFT,
@@ -72,7 +81,89 @@ bool verify_received_data(const uint8_t *recv_data, uint16_t data_len) {
   return true;
 }
 
+// ========================== 快速通道 ==========================
+/**
+ * @brief 验证成功回调（弱定义，中断上下文调用，应用层覆盖以驱动开锁输出）
+ * @param user_id 验证通过的用户ID
+ * @note  只做GPIO动作，显示与日志等耗时操作交由主循环处理
+ */
+__weak void fm225_verify_success_callback(uint16_t user_id) { (void)user_id; }
+
+/**
+ * @brief 在串口接收中断中识别验证成功应答，立即执行开锁动作
+ * @param frame 接收缓冲区（帧从索引0开始）
+ * @param len   接收字节数
+ * @return true: 为验证成功应答且已执行开锁；false: 其他帧，交由主循环处理
+ * @note  只认face_verify发出后的第一条验证应答（fm225_verify_armed），中止、超时后
+ *        迟到的应答不开锁；时延从USART1或接收DMA中断入口（fm225_rx_cycles）计到回调返回
+ */
+bool fm225_fast_path(const uint8_t *frame, uint16_t len) {
+  // 应答帧：帧头2 + 消息类型1 + 长度2 + 命令1 + 结果1 + 用户ID2 + ... + BCC1
+  if (len < 7 || frame[2] != MID_REPLY || frame[5] != CMD_VERIFY_FACE) {
+    return false;
+  }
+
+  uint16_t frame_len = 6 + (((uint16_t)frame[3] << 8) | frame[4]);
+  if (frame_len < 7 || frame_len > len ||
+      !verify_received_data(frame, frame_len)) {
+    return false;
+  }
+
+  // 第一条验证应答（成功或失败）即解除待命，重复或迟到的应答不再开锁
+  if (!fm225_verify_armed) {
+    return false;
+  }
+  fm225_verify_armed = false;
+  if (frame[6] != MR_SUCCESS || frame_len < 10) {
+    return false;
+  }
+
+  uint16_t user_id = ((uint16_t)frame[7] << 8) | frame[8];
+  if (user_id == 0) {
+    return false;
+  }
+
+  fm225_verify_success_callback(user_id);
+
+  uint32_t us = dwt_cycles_to_us(dwt_cycles() - fm225_rx_cycles);
+  TRACE(TRACE_EV_FAST_PATH, user_id, us);
+  fm225_fast_stats.count++;
+  fm225_fast_stats.latency_us_last = us;
+  if (us > fm225_fast_stats.latency_us_max) {
+    fm225_fast_stats.latency_us_max = us;
+  }
+  if (us > FM225_FAST_BUDGET_US) {
+    fm225_fast_stats.over_budget++;
+  }
+
+  // 用户名紧跟用户ID（索引9起），在开锁之后拷贝，不计入时延
+  uint16_t name_len = frame_len - 10;
+  if (name_len > FM225_NAME_LEN) {
+    name_len = FM225_NAME_LEN;
+  }
+  memcpy(fm225_verified_name, &frame[9], name_len);
+  fm225_verified_name[name_len] = '\0';
+  __DMB(); // 用户名先于标志对主循环可见
+
+  fm225_verified_id = user_id;
+  fm225_verified = true;
+  return true;
+}
+
 // ========================== 功能函数 ==========================
+/**
+ * @brief 取得发送缓冲区用于构建命令帧
+ * @return uint8_t* 清零后的TX_BUFFER；上一帧DMA发送未完成时返回NULL
+ * @note  DMA在函数返回后仍在读取帧数据，命令帧不能放在栈上
+ */
+static uint8_t *fm225_tx_frame(void) {
+  if (huart1.gState != HAL_UART_STATE_READY) {
+    return NULL;
+  }
+  memset(TX_BUFFER, 0x00, sizeof(TX_BUFFER));
+  return TX_BUFFER;
+}
+
 /**
  * @brief 删除指定用户的人脸数据
  * @param 待删除用户的ID
@@ -85,7 +176,10 @@ bool face_delete_user(uint16_t id) {
   }
 
   // 构建删除命令帧：初始化全0，避免未赋值字节的随机值影响校验
-  uint8_t frame[64] = {0};
+  uint8_t *frame = fm225_tx_frame();
+  if (frame == NULL) {
+    return false;
+  }
 
   // 填充帧头（2字节）：固定为FRAME_HEADER，模块识别数据帧的起始标识
   frame[0] = FRAME_HEADER[0];
@@ -103,11 +197,10 @@ bool face_delete_user(uint16_t id) {
   frame[6] = id & 0xFF;        // 第2字节：用户ID低8位
 
   // 计算并填充BCC校验码（1字节，帧尾）：基于整个帧的前5字节计算
-  frame[7] = calculate_bcc(frame, sizeof(frame));
+  frame[7] = calculate_bcc(frame, 8);
 
   // 实际的串口发送逻辑
-  if (HAL_UART_Transmit_DMA(&huart1, (uint8_t *)frame, sizeof(frame)) !=
-      HAL_OK) {
+  if (HAL_UART_Transmit_DMA(&huart1, frame, 8) != HAL_OK) {
     return false;
   }
   return true;
@@ -120,7 +213,10 @@ bool face_delete_user(uint16_t id) {
  */
 bool face_delete_all() {
   // 构建删除命令帧：初始化全0，避免未赋值字节的随机值影响校验
-  uint8_t frame[64] = {0};
+  uint8_t *frame = fm225_tx_frame();
+  if (frame == NULL) {
+    return false;
+  }
 
   // 填充帧头（2字节）：固定为FRAME_HEADER，模块识别数据帧的起始标识
   frame[0] = FRAME_HEADER[0];
@@ -137,8 +233,7 @@ bool face_delete_all() {
   frame[5] = calculate_bcc(frame, 6);
 
   // 实际的串口发送逻辑
-  if (HAL_UART_Transmit_DMA(&huart1, (uint8_t *)frame, sizeof(frame)) !=
-      HAL_OK) {
+  if (HAL_UART_Transmit_DMA(&huart1, frame, 6) != HAL_OK) {
     return false;
   }
   return true;
@@ -151,7 +246,10 @@ bool face_delete_all() {
  */
 bool face_reset() {
   // 构建删除命令帧：初始化全0，避免未赋值字节的随机值影响校验
-  uint8_t frame[64] = {0};
+  uint8_t *frame = fm225_tx_frame();
+  if (frame == NULL) {
+    return false;
+  }
 
   // 填充帧头（2字节）：固定为FRAME_HEADER，模块识别数据帧的起始标识
   frame[0] = FRAME_HEADER[0];
@@ -168,8 +266,7 @@ bool face_reset() {
   frame[5] = calculate_bcc(frame, 6);
 
   // 实际的串口发送逻辑
-  if (HAL_UART_Transmit_DMA(&huart1, (uint8_t *)frame, sizeof(frame)) !=
-      HAL_OK) {
+  if (HAL_UART_Transmit_DMA(&huart1, frame, 6) != HAL_OK) {
     return false;
   }
   return true;
@@ -196,7 +293,10 @@ bool face_verify(uint8_t pd_rightaway, uint8_t timeout) {
   }
 
   // 构建验证命令帧：初始化全0，避免未赋值字节的随机值影响校验
-  uint8_t frame[64] = {0};
+  uint8_t *frame = fm225_tx_frame();
+  if (frame == NULL) {
+    return false;
+  }
 
   // 填充帧头（2字节）：固定起始标识
   frame[0] = FRAME_HEADER[0];
@@ -217,9 +317,10 @@ bool face_verify(uint8_t pd_rightaway, uint8_t timeout) {
   // 计算并填充BCC校验码（1字节，帧尾）：基于前7字节计算
   frame[7] = calculate_bcc(frame, 8);
 
-  // 实际串口发送逻辑
-  if (HAL_UART_Transmit_DMA(&huart1, (uint8_t *)frame, sizeof(frame)) !=
-      HAL_OK) {
+  // 实际串口发送逻辑：应答可能在发送完成前到达，先置待命标志
+  fm225_verify_armed = true;
+  if (HAL_UART_Transmit_DMA(&huart1, frame, 8) != HAL_OK) {
+    fm225_verify_armed = false;
     return false;
   }
 
@@ -282,7 +383,10 @@ bool face_enroll(uint8_t admin, const uint8_t user_name[32],
   }
 
   // 构建注册命令帧：初始化全0，避免未赋值字节的随机值影响校验
-  uint8_t frame[128] = {0};
+  uint8_t *frame = fm225_tx_frame();
+  if (frame == NULL) {
+    return false;
+  }
 
   // 填充帧头（2字节）：固定起始标识
   frame[0] = FRAME_HEADER[0];
@@ -310,8 +414,7 @@ bool face_enroll(uint8_t admin, const uint8_t user_name[32],
   frame[45] = calculate_bcc(frame, 46);
 
   // 实际串口发送逻辑
-  if (HAL_UART_Transmit_DMA(&huart1, (uint8_t *)frame, sizeof(frame)) !=
-      HAL_OK) {
+  if (HAL_UART_Transmit_DMA(&huart1, frame, 46) != HAL_OK) {
     return false;
   }
 
@@ -0,0 +1,127 @@
+#include "fmt.h"
+
+static const char s_digits[] = "0123456789ABCDEF";
+
+/**
+ * @brief 按最小宽度输出已逆序生成的数字
+ * @param dst   输出缓冲区
+ * @param rev   逆序数字（个位在前）
+ * @param n     数字个数
+ * @param sign  符号字符，0表示无符号
+ * @param width 最小宽度（含符号）
+ * @param pad   填充字符：'0'时符号在填充之前（-007），其他字符在符号之前（  -7）
+ * @return char* 指向结尾'\0'
+ */
+static char *fmt_emit(char *dst, const char *rev, uint8_t n, char sign,
+                      uint8_t width, char pad) {
+  uint8_t len = n + (sign != 0);
+
+  if (sign != 0 && pad == '0') {
+    *dst++ = sign;
+  }
+  while (width > len) {
+    *dst++ = pad;
+    width--;
+  }
+  if (sign != 0 && pad != '0') {
+    *dst++ = sign;
+  }
+  while (n > 0) {
+    *dst++ = rev[--n];
+  }
+  *dst = '\0';
+  return dst;
+}
+
+/**
+ * @brief 无符号整数
+ * @param dst   输出缓冲区
+ * @param value 数值
+ * @param width 最小宽度
+ * @param pad   填充字符（'0'或' '）
+ * @param base  进制（2~16），超出范围时只写'\0'（空串）
+ * @return char* 指向结尾'\0'
+ * @note  每位一次除法（从低位生成），不做幂运算
+ */
+char *fmt_u32(char *dst, uint32_t value, uint8_t width, char pad,
+              uint8_t base) {
+  char rev[FMT_U32_DIGITS];
+  uint8_t n = 0;
+
+  if (base < 2 || base > 16) { // 0会除零，大于16会越过数字表
+    *dst = '\0';
+    return dst;
+  }
+  do {
+    rev[n++] = s_digits[value % base];
+    value /= base;
+  } while (value != 0);
+  return fmt_emit(dst, rev, n, 0, width, pad);
+}
+
+/**
+ * @brief 有符号十进制整数
+ * @param dst   输出缓冲区
+ * @param value 数值
+ * @param width 最小宽度（含负号）
+ * @param pad   填充字符（'0'或' '）
+ * @return char* 指向结尾'\0'
+ */
+char *fmt_i32(char *dst, int32_t value, uint8_t width, char pad) {
+  char rev[10];
+  uint8_t n = 0;
+  uint32_t mag = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+
+  do {
+    rev[n++] = (char)('0' + mag % 10U);
+    mag /= 10U;
+  } while (mag != 0);
+  return fmt_emit(dst, rev, n, (value < 0) ? '-' : 0, width, pad);
+}
+
+/**
+ * @brief 定点小数：value为实际值乘以10^decimals，如fmt_fixed(buf, -1234, 2, 0, ' ')输出"-12.34"
+ * @param dst      输出缓冲区
+ * @param value    定点数值
+ * @param decimals 小数位数（0~9，0时不输出小数点）
+ * @param width    最小宽度（含负号与小数点）
+ * @param pad      填充字符（'0'或' '）
+ * @return char* 指向结尾'\0'
+ */
+char *fmt_fixed(char *dst, int32_t value, uint8_t decimals, uint8_t width,
+                char pad) {
+  char rev[11];
+  uint8_t n = 0;
+  uint32_t mag = (value < 0) ? 0U - (uint32_t)value : (uint32_t)value;
+
+  if (decimals > 9) {
+    decimals = 9;
+  }
+  // 小数部分逐位生成，不足decimals位补0；之后至少一位整数
+  while (n < decimals) {
+    rev[n++] = (char)('0' + mag % 10U);
+    mag /= 10U;
+  }
+  if (decimals > 0) {
+    rev[n++] = '.';
+  }
+  do {
+    rev[n++] = (char)('0' + mag % 10U);
+    mag /= 10U;
+  } while (mag != 0);
+  return fmt_emit(dst, rev, n, (value < 0) ? '-' : 0, width, pad);
+}
+
+/**
+ * @brief 复制字符串
+ * @param dst 输出缓冲区
+ * @param src 源字符串
+ * @return char* 指向结尾'\0'
+ */
+char *fmt_str(char *dst, const char *src) {
+  while (*src != '\0') {
+    *dst++ = *src++;
+  }
+  *dst = '\0';
+  return dst;
+}
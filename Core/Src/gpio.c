@@ -58,7 +58,7 @@ void MX_GPIO_Init(void)
   HAL_GPIO_WritePin(IO3_GPIO_Port, IO3_Pin, GPIO_PIN_SET);
 
   /*Configure GPIO pin Output Level */
-  HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_RESET);
+  HAL_GPIO_WritePin(GPIOB, LOCK_Pin|FM225_CTL_Pin, GPIO_PIN_RESET);
 
   /*Configure GPIO pins : IO1_Pin IO5_Pin IO2_Pin IO6_Pin
                            IO7_Pin IO4_Pin */
@@ -76,6 +76,13 @@ void MX_GPIO_Init(void)
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
   HAL_GPIO_Init(IO3_GPIO_Port, &GPIO_InitStruct);
 
+  /*Configure GPIO pin : LOCK_Pin */
+  GPIO_InitStruct.Pin = LOCK_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(LOCK_GPIO_Port, &GPIO_InitStruct);
+
   /*Configure GPIO pins : KEY3_Pin KEY0_Pin */
   GPIO_InitStruct.Pin = KEY3_Pin|KEY0_Pin;
   GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
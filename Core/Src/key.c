@@ -0,0 +1,145 @@
+#include "key.h"
+#include "main.h"
+#include "tim.h"
+
+// 消抖后的按键状态（1=按下），各位对应KEY_0~KEY_3
+static volatile uint8_t s_state = 0;
+// 2位垂直计数器：4个按键的积分计数并行进行，连续4次采样一致才翻转状态
+static uint8_t s_ct0 = 0xFF;
+static uint8_t s_ct1 = 0xFF;
+// 允许连发的按键掩码（由当前界面设置）
+static volatile uint8_t s_repeat_mask = 0;
+// 已触发长按事件的按键掩码
+static uint8_t s_long_sent = 0;
+
+static uint32_t s_hold_ms[KEY_NUM];         // 按住时长
+static uint32_t s_next_repeat_ms[KEY_NUM];  // 下一次连发的按住时长
+static uint32_t s_repeat_interval[KEY_NUM]; // 当前连发间隔
+
+/**
+ * @brief 按键事件回调（弱定义，在TIM1中断上下文中调用，应用层覆盖）
+ * @param event 按键事件
+ */
+__weak void key_event_callback(const key_event_t *event) { (void)event; }
+
+/**
+ * @brief 一次性采样全部按键引脚（低电平有效）
+ * @return uint8_t 原始按键位图（1=按下）
+ */
+static uint8_t key_read_raw(void) {
+  uint8_t raw = 0;
+  uint32_t pa = GPIOA->IDR;
+  uint32_t pb = GPIOB->IDR;
+
+  if (!(pb & KEY0_Pin)) {
+    raw |= KEY_MASK(KEY_0);
+  }
+  if (!(pa & KEY1_Pin)) {
+    raw |= KEY_MASK(KEY_1);
+  }
+  if (!(pa & KEY2_Pin)) {
+    raw |= KEY_MASK(KEY_2);
+  }
+  if (!(pb & KEY3_Pin)) {
+    raw |= KEY_MASK(KEY_3);
+  }
+  return raw;
+}
+
+static void key_emit(uint8_t key, key_event_type_t type, uint32_t tick) {
+  key_event_t event = {.key = key, .type = type, .tick = tick};
+  key_event_callback(&event);
+}
+
+/**
+ * @brief 启动周期扫描（扫描进行中则不做任何操作）
+ */
+static void key_scan_start(void) {
+  if ((htim1.Instance->CR1 & TIM_CR1_CEN) == 0) {
+    __HAL_TIM_SET_COUNTER(&htim1, 0);
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+    HAL_TIM_Base_Start_IT(&htim1);
+  }
+}
+
+/**
+ * @brief 按键外部中断处理：任一按键出现下降沿即启动扫描
+ * @param GPIO_Pin 触发中断的引脚
+ */
+void key_exti_callback(uint16_t GPIO_Pin) {
+  if (GPIO_Pin == KEY0_Pin || GPIO_Pin == KEY1_Pin || GPIO_Pin == KEY2_Pin ||
+      GPIO_Pin == KEY3_Pin) {
+    key_scan_start();
+  }
+}
+
+/**
+ * @brief 周期扫描（TIM1更新中断中每KEY_SCAN_PERIOD_MS调用一次）
+ * @note  所有按键释放且积分器稳定后自动停止TIM1，空闲时不占用CPU
+ */
+void key_scan_tick(void) {
+  uint32_t tick = HAL_GetTick();
+  uint8_t raw = key_read_raw();
+
+  // 垂直计数器积分消抖：changed位连续4次为1时翻转对应按键状态
+  uint8_t changed = s_state ^ raw;
+  s_ct0 = ~(s_ct0 & changed);
+  s_ct1 = s_ct0 ^ (s_ct1 & changed);
+  changed &= s_ct0 & s_ct1;
+  s_state ^= changed;
+
+  uint8_t pressed = s_state & changed;
+  uint8_t released = ~s_state & changed;
+
+  for (uint8_t key = 0; key < KEY_NUM; key++) {
+    uint8_t mask = KEY_MASK(key);
+
+    if (pressed & mask) {
+      s_hold_ms[key] = 0;
+      s_long_sent &= ~mask;
+      key_emit(key, KEY_EVENT_PRESS, tick);
+    } else if (released & mask) {
+      key_emit(key, KEY_EVENT_RELEASE, tick);
+    } else if (s_state & mask) {
+      s_hold_ms[key] += KEY_SCAN_PERIOD_MS;
+
+      if (!(s_long_sent & mask)) {
+        if (s_hold_ms[key] >= KEY_LONG_PRESS_MS) {
+          s_long_sent |= mask;
+          key_emit(key, KEY_EVENT_LONG, tick);
+          s_repeat_interval[key] = KEY_REPEAT_START_MS;
+          s_next_repeat_ms[key] = s_hold_ms[key];
+        }
+      }
+      // 连发间隔逐次缩短1/8，直至KEY_REPEAT_MIN_MS
+      if ((s_long_sent & s_repeat_mask & mask) &&
+          s_hold_ms[key] >= s_next_repeat_ms[key]) {
+        key_emit(key, KEY_EVENT_REPEAT, tick);
+        uint32_t interval = s_repeat_interval[key];
+        interval -= interval >> KEY_REPEAT_ACCEL_SHIFT;
+        if (interval < KEY_REPEAT_MIN_MS) {
+          interval = KEY_REPEAT_MIN_MS;
+        }
+        s_repeat_interval[key] = interval;
+        s_next_repeat_ms[key] += interval;
+      }
+    }
+  }
+
+  // 全部释放且原始电平也已稳定，停止扫描
+  if (s_state == 0 && raw == 0) {
+    HAL_TIM_Base_Stop_IT(&htim1);
+  }
+}
+
+/**
+ * @brief 设置允许连发的按键
+ * @param mask 按键掩码（KEY_MASK组合），0表示全部禁止连发
+ */
+void key_set_repeat_mask(uint8_t mask) { s_repeat_mask = mask; }
+
+/**
+ * @brief 读取消抖后的按键状态
+ * @return uint8_t 按键位图（1=按下）
+ */
+uint8_t key_state(void) { return s_state; }
@@ -0,0 +1,23 @@
+#include "lang.h"
+
+const char *const *lang_str_table = strtab[0];
+const oled_screen_t *const *lang_scr_table = scr_lang[0];
+static lang_t s_lang = (lang_t)0;
+
+/**
+ * @brief 切换界面语言，之后的STR/SCREEN取新语言（已显示的内容需重绘）
+ * @param lang 语言，超出范围时使用默认语言（如备份寄存器未写过）
+ */
+void lang_set(lang_t lang) {
+  if ((unsigned)lang >= LANG_COUNT) {
+    lang = (lang_t)0;
+  }
+  s_lang = lang;
+  lang_str_table = strtab[lang];
+  lang_scr_table = scr_lang[lang];
+}
+
+/**
+ * @brief 当前界面语言
+ */
+lang_t lang_get(void) { return s_lang; }
@@ -27,21 +27,61 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "anim.h"
 #include "fm225.h"
+#include "fmt.h"
+#include "key.h"
+#include "lang.h"
+#include "marquee.h"
 #include "oled.h"
+#include "oled_mirror.h"
+#include "oled_pm.h"
+#include "oled_queue.h"
+#include "power.h"
+#include "progress.h"
+#include "swtimer.h"
+#include "trace.h"
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
+// 界面状态
+typedef enum {
+  UI_BOOT,          // 等待OLED上电稳定
+  UI_MAIN,          // 主菜单
+  UI_ENROLL_SELECT, // 选择注册序号
+  UI_DELETE_SELECT, // 选择删除序号
+  UI_WAIT_READY,    // 等待FM225上电就绪
+  UI_WAIT_REPLY,    // 等待命令应答
+  UI_RESULT,        // 显示操作结果
+  UI_CLOCK,         // 大字时钟（主菜单无操作、面板调暗后显示）
+} ui_state_t;
+
+// 当前进行的模块操作
+typedef enum {
+  UI_OP_ENROLL, // 注册人脸
+  UI_OP_VERIFY, // 验证人脸
+  UI_OP_DELETE, // 删除人脸
+} ui_op_t;
 
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define OLED_POWERUP_MS 300        // OLED上电稳定时间
+#define FM225_READY_MS 3000        // 等待模块就绪超时
+#define FM225_CMD_TIMEOUT_S 10     // 录入/验证超时（模块内部计时，秒）
+#define FM225_REPLY_MARGIN_MS 2000 // 录入/验证应答超时余量
+#define FM225_DELETE_REPLY_MS 2000 // 删除应答超时
+#define VOICE_PROMPT_MS 2000       // 语音触发电平保持时间
+#define RESULT_HOLD_MS 5000        // 结果显示时间，到期返回主菜单
+#define UNLOCK_HOLD_MS 3000        // 开锁输出保持时间
+#define RESULT_BLINK_COUNT 3       // 结果标题行反显闪烁次数
+#define SPINNER_X 116              // 等待模块时转圈图案的列（提示文字右侧）
+#define LANG_BKP_REG RTC_BKP_DR2   // 保存界面语言的备份寄存器（DR1为RTC初始化标记）
 
 /* USER CODE END PD */
 
@@ -53,19 +93,28 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-uint8_t KEY0_PRESSED = 0;
-uint8_t KEY1_PRESSED = 0;
-uint8_t KEY2_PRESSED = 0;
-uint8_t KEY3_PRESSED = 0;
+static volatile uint8_t s_key_pending = 0;  // 待处理按键（KEY_MASK位图）
+static volatile uint8_t s_key_long = 0;     // 待处理长按（KEY_MASK位图）
+static volatile bool s_ui_timeout = false;  // 当前状态超时
+static volatile bool s_clock_dirty = false; // 时间行待刷新
+static volatile uint32_t s_clock_minute = UINT32_MAX; // 已显示的分钟（RTC计数/60），UINT32_MAX表示需整行重绘
+static char s_clock_text[17];                // 已显示的时间行"YYYY-MM-DD HH:MM"
+static char s_big_clock[9];                  // 已显示的大字时间"HH:MM:SS"
+static ui_state_t s_ui_state = UI_BOOT;
+static ui_op_t s_ui_op = UI_OP_VERIFY;
+static swtimer_t s_ui_timer;    // 状态超时定时器
+static uint32_t s_ui_deadline;  // s_ui_timer的到期时刻（HAL_GetTick）
+static swtimer_t s_voice_timer; // 语音提示定时器
+static swtimer_t s_lock_timer;  // 开锁保持定时器
 uint8_t g_user_name = 1;
 uint8_t g_delete_id = 1;
 
-int menu_main();
-int menu_enroll();
-int menu_verify();
-int menu_delete();
-void OLED_ShowTime();
-int (*menu)() = &menu_main;
+static void ui_enter(ui_state_t state);
+static void ui_poll(void);
+void OLED_ShowTime(void);
+static void clock_invalidate(void);
+static void show_big_clock(void);
+static void ui_idle_poll(void);
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -113,38 +162,27 @@ int main(void)
   MX_RTC_Init();
   MX_USART1_UART_Init();
   MX_TIM1_Init();
+  MX_USART3_UART_Init();
   /* USER CODE BEGIN 2 */
+  swtimer_init();                              // 软件定时器初始化
   rtc_init_user();                             // RTC初始化
+  lang_set((lang_t)HAL_RTCEx_BKUPRead(&hrtc, LANG_BKP_REG)); // 上次选择的界面语言
   __HAL_UART_ENABLE_IT(&huart1, UART_IT_IDLE); // 使能串口IDLE中断
   HAL_UARTEx_ReceiveToIdle_DMA(&huart1, (uint8_t *)RX_BUFFER, RX_BUFF_SIZE);
-  HAL_TIM_Base_Start_IT(&htim1); // 按键消抖
-  OLED_Init();                   // OLED初始
-  HAL_Delay(100);
-  OLED_IntensityControl(0xFF); // OLED亮度设置
+  HAL_TIM_Base_Start_IT(&htim1); // 按键扫描（按键释放后自动停止）
+  power_init();                  // 低功耗管理初始化
+  TRACE(TRACE_EV_BOOT, 0, 0);
+  ui_enter(UI_BOOT);             // 等待OLED上电后初始化
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1) {
-    if (KEY1_PRESSED == 1) {
-      menu = menu_main;
-    }
-    if (KEY3_PRESSED == 1) {
-      menu = menu_enroll;
-    }
-    if (KEY2_PRESSED == 1) {
-      menu = menu_verify;
-    }
-    if (KEY0_PRESSED == 1) {
-      menu = menu_delete;
-    }
-    if (menu != NULL) {
-      KEY0_PRESSED = 0;
-      KEY1_PRESSED = 0;
-      KEY2_PRESSED = 0;
-      KEY3_PRESSED = 0;
-      menu();
-    }
+    ui_poll();           // 处理按键、模块消息与定时器事件
+    oled_queue_poll();   // 显示队列：执行帧尾标记（传输由DMA完成中断连续启动）
+    trace_drain();       // 跟踪记录经USART3输出
+    oled_mirror_drain(); // 面板镜像（OLED_MIRROR_ENABLE）与跟踪记录轮流使用USART3
+    power_idle();        // 无操作时进入Stop模式，按键/RTC闹钟/串口唤醒
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -211,611 +249,591 @@ uint8_t calculateBCC(uint8_t *data, int length) {
   return bcc;
 }
 
-int menu_main() {
-  menu = NULL;
-  OLED_ClearRows(2, 7); // 清空2~7行
-
-  OLED_ShowCHinese(32, 2, 0, 0);
-  OLED_ShowCHinese(48, 2, 1, 0);
-  OLED_ShowCHinese(64, 2, 6, 0);
-  OLED_ShowCHinese(80, 2, 7, 0);
-
-  OLED_ShowCHinese(32, 4, 4, 0);
-  OLED_ShowCHinese(48, 4, 5, 0);
-  OLED_ShowCHinese(64, 4, 6, 0);
-  OLED_ShowCHinese(80, 4, 7, 0);
-
-  OLED_ShowCHinese(32, 6, 2, 0);
-  OLED_ShowCHinese(48, 6, 3, 0);
-  OLED_ShowCHinese(64, 6, 6, 0);
-  OLED_ShowCHinese(80, 6, 7, 0);
-  return 0;
+// ========================== 语音与开锁输出 ==========================
+// 语音提示到期：释放所有语音触发引脚（SysTick中断上下文）
+static void voice_release_cb(void *arg) {
+  (void)arg;
+  GPIOA->BSRR = IO1_Pin | IO2_Pin | IO4_Pin | IO5_Pin | IO6_Pin | IO7_Pin;
+  IO3_GPIO_Port->BSRR = IO3_Pin;
 }
-int menu_enroll() {
-  OLED_ClearRows(2, 7); // 清空2~7行
 
-  OLED_ShowCHinese(0, 2, 8, 0);   // 再
-  OLED_ShowCHinese(16, 2, 9, 0);  // 按
-  OLED_ShowCHinese(32, 2, 10, 0); // 一
-  OLED_ShowCHinese(48, 2, 11, 0); // 次
+// 拉低语音触发引脚播放提示音，VOICE_PROMPT_MS后自动释放
+static void voice_play(GPIO_TypeDef *port, uint16_t pin) {
+  port->BSRR = (uint32_t)pin << 16U;
+  swtimer_start(&s_voice_timer, VOICE_PROMPT_MS, voice_release_cb, NULL);
+}
 
-  OLED_ShowCHinese(64, 2, 0, 0);  // 注
-  OLED_ShowCHinese(80, 2, 1, 0);  // 册
-  OLED_ShowCHinese(96, 2, 6, 0);  // 人
-  OLED_ShowCHinese(112, 2, 7, 0); // 脸
+// 开锁保持时间到，重新上锁（SysTick中断上下文）
+static void lock_release_cb(void *arg) {
+  (void)arg;
+  LOCK_GPIO_Port->BSRR = (uint32_t)LOCK_Pin << 16U;
+}
 
-  OLED_ShowCHinese(32, 4, 12, 0); // 序
-  OLED_ShowCHinese(48, 4, 13, 0); // 号
-  OLED_ShowCHinese(64, 4, 14, 0); // ：
-  OLED_ShowNum(80, 4, g_user_name, 2, 16, 0);
+// FM225模块电源控制
+static void module_power(bool on) {
+  HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
+                    on ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
 
-  while (1) {
-    if (KEY3_PRESSED == 1) {
-      KEY3_PRESSED = 0;
-      OLED_ClearRows(2, 7); // 清空2~7行
-
-      OLED_ShowCHinese(40, 2, 0, 0);  // 注
-      OLED_ShowCHinese(56, 2, 1, 0);  // 册
-      OLED_ShowCHinese(72, 2, 15, 0); // 中
-
-      OLED_ShowCHinese(16, 4, 35, 0); // 设
-      OLED_ShowCHinese(32, 4, 36, 0); // 备
-      OLED_ShowCHinese(48, 4, 33, 0); // 正
-      OLED_ShowCHinese(64, 4, 39, 0); // 在
-      OLED_ShowCHinese(80, 4, 37, 0); // 连
-      OLED_ShowCHinese(96, 4, 38, 0); // 接
-
-      // 重置 user_buffer 和 user_buffer_len
-      user_buffer_len = 0;
-      memset(user_buffer, 0x00, sizeof(user_buffer));
-
-      HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                        GPIO_PIN_SET); // 打开FM225的电源
-      uint8_t ready_msg[7] = {0XEF, 0XAA, 0X01, 0X00, 0X01, 0X00, 0X00};
-
-      // 等待收到开机准备好的消息
-      while (strcmp((const char *)user_buffer, (const char *)ready_msg) != 0) {
-        if (KEY2_PRESSED == 1) {
-          KEY2_PRESSED = 0;
-        }
-
-        if (KEY0_PRESSED == 1) {
-          KEY0_PRESSED = 0;
-        }
-        if (KEY3_PRESSED == 1) {
-          KEY3_PRESSED = 0;
-        }
-        if (KEY1_PRESSED == 1) {
-          KEY1_PRESSED = 0;
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                            GPIO_PIN_RESET); // 关闭FM225的电源
-          menu = menu_main;
-          return 0;
-        }
-      }
+// ========================== 界面绘制 ==========================
+// 静态文字为构建时按语言预渲染的位图（assets/screens.txt），序号行等动态内容由OLED_DrawText
+// 排版叠加；文字均取自当前语言的文字表（lang.h）
+static void screen_main(void) { OLED_ShowScreen(SCREEN(SCR_MAIN)); }
+
+// 序号行居中显示在第4页：文字与数字一起排版，两位数字宽度固定，
+// 数字变化时只有数字所在的列改动
+static void show_id_line(const char *prefix, uint8_t id, const char *suffix) {
+  char buf[24];
+  char *p = fmt_str(buf, prefix);
+  p = fmt_u32(p, id, 2, ' ', 10);
+  fmt_str(p, suffix);
+  OLED_DrawText(OLED_WIDTH / 2, 32, buf, OLED_ALIGN_CENTER, OLED_COPY);
+}
 
-      uint8_t user_name[32] = {0};
-      user_name[0] = g_user_name;
-      face_enroll(0x01, user_name, FACE_DIRECTION_UNDEFINED, 0x01, 0x00, 10);
-
-      // 等待收到验证结果
-      while (1) {
-        if (user_buffer[2] == 0X01 && user_buffer[3] == 0X00 &&
-            user_buffer[4] == 0X11 && user_buffer[5] == 0X01 &&
-            user_buffer[6] == 0X01) {
-          // 重置 user_buffer 和 user_buffer_len
-          user_buffer_len = 0;
-          memset(user_buffer, 0x00, sizeof(user_buffer));
-
-          OLED_ShowCHinese(16, 4, 29, 0); // 未
-          OLED_ShowCHinese(32, 4, 30, 0); // 检
-          OLED_ShowCHinese(48, 4, 31, 0); // 测
-          OLED_ShowCHinese(64, 4, 32, 0); // 到
-          OLED_ShowCHinese(80, 4, 6, 0);  // 人
-          OLED_ShowCHinese(96, 4, 7, 0);  // 脸
-        }
-        if (user_buffer[2] == 0X01 && user_buffer[3] == 0X00 &&
-            user_buffer[4] == 0X11 && user_buffer[5] == 0X01 &&
-            user_buffer[6] == 0X00) {
-          // 重置 user_buffer 和 user_buffer_len
-          user_buffer_len = 0;
-          memset(user_buffer, 0x00, sizeof(user_buffer));
-
-          OLED_ClearRows(4, 5); // 清空4~5行
-
-          OLED_ShowCHinese(32, 4, 6, 0);  // 人
-          OLED_ShowCHinese(48, 4, 7, 0);  // 脸
-          OLED_ShowCHinese(64, 4, 33, 0); // 正
-          OLED_ShowCHinese(80, 4, 34, 0); // 常
-        }
-        if ((user_buffer[2] == 0X00) && (user_buffer[5] == CMD_ENROLL_ITG) &&
-            (user_buffer[6] == 0X0A)) {
-
-          user_buffer_len = 0;
-          memset(user_buffer, 0x00, sizeof(user_buffer));
-
-          // 播放人脸已录入语音
-          HAL_GPIO_WritePin(IO3_GPIO_Port, IO3_Pin, GPIO_PIN_RESET);
-
-          // 关闭FM225的电源
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_RESET);
-          OLED_ClearRows(2, 7); // 清空2~7行
-
-          OLED_ShowCHinese(24, 2, 6, 0);  // 人
-          OLED_ShowCHinese(40, 2, 7, 0);  // 脸
-          OLED_ShowCHinese(56, 2, 20, 0); // 已
-          OLED_ShowCHinese(72, 2, 21, 0); // 录
-          OLED_ShowCHinese(88, 2, 22, 0); // 入
-
-          while (1) {
-            if (KEY3_PRESSED == 1) {
-              KEY3_PRESSED = 0;
-            }
-            if (KEY2_PRESSED == 1) {
-              KEY2_PRESSED = 0;
-            }
-
-            if (KEY0_PRESSED == 1) {
-              KEY0_PRESSED = 0;
-            }
-            if (KEY1_PRESSED == 1) {
-              KEY1_PRESSED = 0;
-              HAL_GPIO_WritePin(IO3_GPIO_Port, IO3_Pin, GPIO_PIN_SET);
-              menu = menu_main;
-              return 0;
-            }
-          }
-        } else if ((user_buffer[2] == 0X00) &&
-                   (user_buffer[5] == CMD_ENROLL_ITG) &&
-                   (user_buffer[6] == 0X00) && (user_buffer[8] != 0X00)) {
-
-          // 重置 user_buffer 和 user_buffer_len
-          user_buffer_len = 0;
-          memset(user_buffer, 0x00, sizeof(user_buffer));
-
-          // 播放录入成功语音
-          HAL_GPIO_WritePin(IO1_GPIO_Port, IO1_Pin, GPIO_PIN_RESET);
-
-          // 关闭FM225的电源
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_RESET);
-          OLED_ClearRows(2, 7);           // 清空2~7行
-          OLED_ShowCHinese(32, 2, 21, 0); // 录
-          OLED_ShowCHinese(48, 2, 22, 0); // 入
-          OLED_ShowCHinese(64, 2, 16, 0); // 成
-          OLED_ShowCHinese(80, 2, 17, 0); // 功
-
-          while (1) {
-            if (KEY3_PRESSED == 1) {
-              KEY3_PRESSED = 0;
-            }
-            if (KEY2_PRESSED == 1) {
-              KEY2_PRESSED = 0;
-            }
-
-            if (KEY0_PRESSED == 1) {
-              KEY0_PRESSED = 0;
-            }
-            if (KEY1_PRESSED == 1) {
-              KEY1_PRESSED = 0;
-              HAL_GPIO_WritePin(IO1_GPIO_Port, IO1_Pin, GPIO_PIN_SET);
-              menu = menu_main;
-              return 0;
-            }
-          }
-        } else if ((user_buffer[2] == 0X00) &&
-                   (user_buffer[5] == CMD_ENROLL_ITG) &&
-                   (user_buffer[6] == 0X0D)) {
-
-          // 重置 user_buffer 和 user_buffer_len
-          user_buffer_len = 0;
-          memset(user_buffer, 0x00, sizeof(user_buffer));
-
-          // 播放录入失败语音
-          HAL_GPIO_WritePin(IO2_GPIO_Port, IO2_Pin, GPIO_PIN_RESET);
-
-          // 关闭FM225的电源
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_RESET);
-          OLED_ClearRows(2, 7); // 清空2~7行
-          OLED_ShowCHinese(32, 2, 21, 0);
-          OLED_ShowCHinese(48, 2, 22, 0);
-          OLED_ShowCHinese(64, 2, 18, 0);
-          OLED_ShowCHinese(80, 2, 19, 0);
-
-          while (1) {
-            if (KEY3_PRESSED == 1) {
-              KEY3_PRESSED = 0;
-            }
-            if (KEY2_PRESSED == 1) {
-              KEY2_PRESSED = 0;
-            }
-
-            if (KEY0_PRESSED == 1) {
-              KEY0_PRESSED = 0;
-            }
-            if (KEY1_PRESSED == 1) {
-              KEY1_PRESSED = 0;
-              menu = menu_main;
-              return 0;
-            }
-          }
-        }
-        if (KEY2_PRESSED == 1) {
-          KEY2_PRESSED = 0;
-        }
-        if (KEY3_PRESSED == 1) {
-          KEY3_PRESSED = 0;
-        }
-        if (KEY0_PRESSED == 1) {
-          KEY0_PRESSED = 0;
-        }
-        if (KEY1_PRESSED == 1) {
-          KEY1_PRESSED = 0;
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                            GPIO_PIN_RESET); // 关闭FM225的电源
-          menu = menu_main;
-          return 0;
-        }
-      }
-    }
-    if (KEY2_PRESSED == 1) {
-      KEY2_PRESSED = 0;
-      if (g_user_name < 99) {
-        g_user_name++;
-        OLED_ShowNum(80, 4, g_user_name, 2, 16, 0);
-      }
-    }
-    if (KEY0_PRESSED == 1) {
-      KEY0_PRESSED = 0;
-      if (g_user_name > 1) {
-        g_user_name--;
-        OLED_ShowNum(80, 4, g_user_name, 2, 16, 0);
-      }
-    }
-    if (KEY1_PRESSED == 1) {
+// 大字序号行（选择序号界面）：数字2倍放大占第4~7页，前后文字与数字底部对齐在第6~7页，
+// 整行居中；同样两位定宽，调整序号时只重画数字的32列
+static void show_big_id_line(const char *prefix, uint8_t id, const char *suffix) {
+  char num[4];
+  int16_t x;
+  fmt_u32(num, id, 2, ' ', 10);
+  x = (int16_t)(OLED_WIDTH - OLED_TextWidth(prefix) - OLED_TextWidth(num) * 2 -
+                OLED_TextWidth(suffix)) / 2;
+  x += OLED_DrawText(x, 48, prefix, OLED_ALIGN_LEFT, OLED_COPY);
+  x += OLED_DrawText2X(x, 32, num, OLED_ALIGN_LEFT, OLED_COPY);
+  OLED_DrawText(x, 48, suffix, OLED_ALIGN_LEFT, OLED_COPY);
+}
 
-      KEY1_PRESSED = 0;
-      HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                        GPIO_PIN_RESET); // 关闭FM225的电源
-      menu = menu_main;
-      return 0;
-    }
-  }
+static void show_enroll_id(void) {
+  show_big_id_line(STR(STR_ENROLL_ID_PREFIX), g_user_name, STR(STR_ENROLL_ID_SUFFIX));
 }
-int menu_verify() {
-  while (1) {
 
-    OLED_ClearRows(2, 7); // 清空2~7行
+static void show_delete_id(void) {
+  show_big_id_line(STR(STR_USER_ID_PREFIX), g_delete_id, STR(STR_USER_ID_SUFFIX));
+}
 
-    OLED_ShowCHinese(16, 2, 35, 0); // 设
-    OLED_ShowCHinese(32, 2, 36, 0); // 备
-    OLED_ShowCHinese(48, 2, 33, 0); // 正
-    OLED_ShowCHinese(64, 2, 39, 0); // 在
-    OLED_ShowCHinese(80, 2, 37, 0); // 连
-    OLED_ShowCHinese(96, 2, 38, 0); // 接
+static void screen_enroll_select(void) {
+  OLED_ShowScreen(SCREEN(SCR_ENROLL_SELECT));
+  show_enroll_id();
+}
 
-    // 重置 user_buffer 和 user_buffer_len
-    user_buffer_len = 0;
-    memset(user_buffer, 0x00, sizeof(user_buffer));
+static void screen_delete_select(void) {
+  OLED_ShowScreen(SCREEN(SCR_DELETE_SELECT));
+  show_delete_id();
+}
 
-    HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_SET);
+// 设备正在连接（录入时显示在第4行，验证时显示在第2行）
+static void screen_connecting(void) {
+  OLED_ShowScreen(s_ui_op == UI_OP_ENROLL ? SCREEN(SCR_CONNECTING_ENROLL)
+                                          : SCREEN(SCR_CONNECTING_VERIFY));
+}
 
-    uint8_t ready_msg[7] = {0XEF, 0XAA, 0X01, 0X00, 0X01, 0X00, 0X00};
+// 人脸状态提示（录入时显示在第4行，验证时显示在第2行）
+static void screen_face_state(bool face_normal) {
+  if (s_ui_op == UI_OP_ENROLL)
+    OLED_ShowScreen(face_normal ? SCREEN(SCR_FACE_NORMAL_ENROLL)
+                                : SCREEN(SCR_FACE_NONE_ENROLL));
+  else
+    OLED_ShowScreen(face_normal ? SCREEN(SCR_FACE_NORMAL_VERIFY)
+                                : SCREEN(SCR_FACE_NONE_VERIFY));
+}
 
-    // 等待收到开机准备好的消息
-    while (strcmp((const char *)user_buffer, (const char *)ready_msg) != 0) {
-      if (KEY2_PRESSED == 1) {
-        KEY2_PRESSED = 0;
-      }
+static void screen_verify_success(uint8_t id) {
+  OLED_ShowScreen(SCREEN(SCR_VERIFY_SUCCESS));
+  show_id_line(STR(STR_USER_ID_PREFIX), id, STR(STR_USER_ID_SUFFIX));
+}
 
-      if (KEY0_PRESSED == 1) {
-        KEY0_PRESSED = 0;
-      }
-      if (KEY3_PRESSED == 1) {
-        KEY3_PRESSED = 0;
-      }
-      if (KEY1_PRESSED == 1) {
-        KEY1_PRESSED = 0;
-        HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                          GPIO_PIN_RESET); // 关闭FM225的电源
-        menu = menu_main;
-        return 0;
-      }
+// 验证成功的用户名显示在第6行，超宽时滚动（须在ui_finish之后调用，切换界面会停止滚动）
+// 本机录入的用户名只有1字节序号（ui_send_command），不是文字，不显示
+static void screen_user_name(const char *name) {
+  uint8_t n = 0;
+  while (name[n] != '\0') {
+    if ((uint8_t)name[n] < 0x20 || name[n] == 0x7F) {
+      return;
     }
+    n++;
+  }
+  if (n >= 2) {
+    anim_blink_stop(); // 闪烁会打断面板滚动，用户名滚动优先
+    marquee_start(6, name, n);
+  }
+}
 
-    // 调用验证函数
-    face_verify(0x01, 10);
-
-    while (1) {
-      if (user_buffer[2] == 0X01 && user_buffer[3] == 0X00 &&
-          user_buffer[4] == 0X11 && user_buffer[5] == 0X01 &&
-          user_buffer[6] == 0X01) {
-        // 重置 user_buffer 和 user_buffer_len
-        user_buffer_len = 0;
-        memset(user_buffer, 0x00, sizeof(user_buffer));
-
-        OLED_ShowCHinese(16, 2, 29, 0); // 未
-        OLED_ShowCHinese(32, 2, 30, 0); // 检
-        OLED_ShowCHinese(48, 2, 31, 0); // 测
-        OLED_ShowCHinese(64, 2, 32, 0); // 到
-        OLED_ShowCHinese(80, 2, 6, 0);  // 人
-        OLED_ShowCHinese(96, 2, 7, 0);  // 脸
-      }
-      if (user_buffer[2] == 0X01 && user_buffer[3] == 0X00 &&
-          user_buffer[4] == 0X11 && user_buffer[5] == 0X01 &&
-          user_buffer[6] == 0X00) {
-        // 重置 user_buffer 和 user_buffer_len
-        user_buffer_len = 0;
-        memset(user_buffer, 0x00, sizeof(user_buffer));
-
-        OLED_ClearRows(2, 3); // 清空2~3行
-
-        OLED_ShowCHinese(32, 2, 6, 0);  // 人
-        OLED_ShowCHinese(48, 2, 7, 0);  // 脸
-        OLED_ShowCHinese(64, 2, 33, 0); // 正
-        OLED_ShowCHinese(80, 2, 34, 0); // 常
-      }
-
-      if (user_buffer[2] == 0X00 && user_buffer[5] == CMD_VERIFY_FACE &&
-          user_buffer[6] == 0X00 && user_buffer[8] != 0X00) {
-
-        HAL_GPIO_WritePin(IO5_GPIO_Port, IO5_Pin,
-                          GPIO_PIN_RESET); // 播放验证成功语音
-
-        HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                          GPIO_PIN_RESET); // 关闭FM225电源
-
-        // 重置 user_buffer 和 user_buffer_len
-        user_buffer_len = 0;
-        memset(user_buffer, 0x00, sizeof(user_buffer));
-
-        uint8_t id = user_buffer[8];
-        OLED_ShowNum(72, 2, user_buffer[8], 2, 16, 0);
+// 操作失败提示（模块无应答或返回失败）
+static void screen_op_failed(void) {
+  switch (s_ui_op) {
+  case UI_OP_ENROLL:
+    OLED_ShowScreen(SCREEN(SCR_ENROLL_FAILED));
+    break;
+  case UI_OP_VERIFY:
+    OLED_ShowScreen(SCREEN(SCR_VERIFY_FAILED));
+    break;
+  case UI_OP_DELETE:
+    OLED_ShowScreen(SCREEN(SCR_DELETE_FAILED));
+    break;
+  }
+}
 
-        OLED_ClearRows(2, 3);           // 清空2~3行
-        OLED_ShowCHinese(32, 2, 2, 0);  // 验
-        OLED_ShowCHinese(48, 2, 3, 0);  // 证
-        OLED_ShowCHinese(64, 2, 16, 0); // 成
-        OLED_ShowCHinese(80, 2, 17, 0); // 功
+// ========================== 界面状态机 ==========================
+static void ui_timeout_cb(void *arg) {
+  (void)arg;
+  s_ui_timeout = true;
+}
 
-        OLED_ShowCHinese(24, 4, 25, 0); // 库
-        OLED_ShowCHinese(40, 4, 26, 0); // 中
-        OLED_ShowCHinese(56, 4, 27, 0); // 第
-        OLED_ShowNum(72, 4, id, 2, 16, 0);
-        OLED_ShowCHinese(88, 4, 28, 0); // 个
-      }
-      if (user_buffer[2] == 0X00 && user_buffer[5] == CMD_VERIFY_FACE &&
-          user_buffer[6] == 0X0D) {
-
-        HAL_GPIO_WritePin(IO6_GPIO_Port, IO6_Pin,
-                          GPIO_PIN_RESET); // 播放验证失败语音
-        HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                          GPIO_PIN_RESET); // 关闭FM225电源
-
-        // 重置 user_buffer 和 user_buffer_len
-        user_buffer_len = 0;
-        memset(user_buffer, 0x00, sizeof(user_buffer));
-
-        OLED_ClearRows(2, 3);           // 清空2~3行
-        OLED_ShowCHinese(32, 2, 2, 0);  // 验
-        OLED_ShowCHinese(48, 2, 3, 0);  // 证
-        OLED_ShowCHinese(64, 2, 18, 0); // 失
-        OLED_ShowCHinese(80, 2, 19, 0); // 败
-      }
-      if (KEY2_PRESSED == 1) {
-        KEY2_PRESSED = 0;
-      }
+// 启动当前状态的超时定时器
+static void ui_arm(uint32_t ms) {
+  s_ui_deadline = HAL_GetTick() + ms;
+  swtimer_start(&s_ui_timer, ms, ui_timeout_cb, NULL);
+}
 
-      if (KEY0_PRESSED == 1) {
-        KEY0_PRESSED = 0;
-      }
-      if (KEY3_PRESSED == 1) {
-        KEY3_PRESSED = 0;
-      }
-      if (KEY1_PRESSED == 1) {
-        KEY1_PRESSED = 0;
-        HAL_GPIO_WritePin(IO5_GPIO_Port, IO5_Pin, GPIO_PIN_SET);
-        HAL_GPIO_WritePin(IO6_GPIO_Port, IO6_Pin, GPIO_PIN_SET);
-        HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_RESET);
-        menu = menu_main;
-        return 0;
-      }
+// 发送当前操作对应的模块命令，返回应答超时时间（0表示发送失败）
+static uint32_t ui_send_command(void) {
+  switch (s_ui_op) {
+  case UI_OP_ENROLL: {
+    uint8_t user_name[32] = {0};
+    user_name[0] = g_user_name;
+    if (face_enroll(0x01, user_name, FACE_DIRECTION_UNDEFINED, 0x01, 0x00,
+                    FM225_CMD_TIMEOUT_S)) {
+      return FM225_CMD_TIMEOUT_S * 1000U + FM225_REPLY_MARGIN_MS;
     }
+    break;
   }
+  case UI_OP_VERIFY:
+    fm225_verified = false;
+    if (face_verify(0x01, FM225_CMD_TIMEOUT_S)) {
+      return FM225_CMD_TIMEOUT_S * 1000U + FM225_REPLY_MARGIN_MS;
+    }
+    break;
+  case UI_OP_DELETE:
+    if (g_delete_id == 0 ? face_delete_all() : face_delete_user(g_delete_id)) {
+      return FM225_DELETE_REPLY_MS;
+    }
+    break;
+  }
+  return 0;
 }
-int menu_delete() {
-
-  OLED_ClearRows(2, 7); // 清空2~7行
-
-  OLED_ShowCHinese(0, 2, 8, 0);   // 再
-  OLED_ShowCHinese(16, 2, 9, 0);  // 按
-  OLED_ShowCHinese(32, 2, 10, 0); // 一
-  OLED_ShowCHinese(48, 2, 11, 0); // 次
 
-  OLED_ShowCHinese(64, 2, 4, 0);  // 注
-  OLED_ShowCHinese(80, 2, 5, 0);  // 册
-  OLED_ShowCHinese(96, 2, 6, 0);  // 人
-  OLED_ShowCHinese(112, 2, 7, 0); // 脸
+// 模块操作结束：关闭模块电源并显示结果，RESULT_HOLD_MS后返回主菜单
+static void ui_finish(void) {
+  module_power(false);
+  ui_enter(UI_RESULT);
+}
 
-  OLED_ShowCHinese(24, 4, 25, 0); // 库
-  OLED_ShowCHinese(40, 4, 26, 0); // 中
-  OLED_ShowCHinese(56, 4, 27, 0); // 第
-  OLED_ShowNum(72, 4, g_delete_id, 2, 16, 0);
-  OLED_ShowCHinese(88, 4, 28, 0); // 个
+// 操作失败（超时或模块返回失败）
+static void ui_fail(void) {
+  module_power(false);
+  screen_op_failed();
+  ui_enter(UI_RESULT);
+}
 
-  while (1) {
-    if (KEY0_PRESSED == 1) {
-      KEY0_PRESSED = 0;
-
-      // 重置 user_buffer 和 user_buffer_len
-      user_buffer_len = 0;
-      memset(user_buffer, 0x00, sizeof(user_buffer));
-
-      HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                        GPIO_PIN_SET); // 打开FM225的电源
-      uint8_t ready_msg[7] = {0XEF, 0XAA, 0X01, 0X00, 0X01, 0X00, 0X00};
-
-      // 等待收到开机准备好的消息
-      while (strcmp((const char *)user_buffer, (const char *)ready_msg) != 0) {
-        if (KEY2_PRESSED == 1) {
-          KEY2_PRESSED = 0;
-        }
-
-        if (KEY0_PRESSED == 1) {
-          KEY0_PRESSED = 0;
-        }
-        if (KEY3_PRESSED == 1) {
-          KEY3_PRESSED = 0;
-        }
-        if (KEY1_PRESSED == 1) {
-          KEY1_PRESSED = 0;
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                            GPIO_PIN_RESET); // 关闭FM225的电源
-          menu = menu_main;
-          return 0;
-        }
-      }
+// 等待模块时在提示文字右侧转圈（录入时提示在第4页，验证时在第2页）
+static void ui_spinner(void) {
+  anim_spinner(SPINNER_X, s_ui_op == UI_OP_ENROLL ? 36 : 20);
+}
 
-      if (g_delete_id == 0) {
-        face_delete_all();
+// 进入新状态：绘制界面并启动该状态的超时定时器
+static void ui_enter(ui_state_t state) {
+  marquee_stop();
+  progress_stop();
+  anim_stop();
+  swtimer_stop(&s_ui_timer);
+  s_ui_timeout = false;
+  fm225_verify_armed = false; // 离开等待应答（中止、超时、完成）后迟到的验证应答不再开锁
+  s_ui_state = state;
+  TRACE(TRACE_EV_UI_STATE, state, s_ui_op);
+  key_set_repeat_mask(0); // 连发由各界面按需开启
+
+  switch (state) {
+  case UI_BOOT:
+    ui_arm(OLED_POWERUP_MS);
+    break;
+  case UI_MAIN:
+    screen_main();
+    anim_wipe();
+    break;
+  case UI_ENROLL_SELECT:
+    key_set_repeat_mask(KEY_MASK(KEY_2) | KEY_MASK(KEY_0)); // 长按连续调整序号
+    screen_enroll_select();
+    anim_wipe();
+    break;
+  case UI_DELETE_SELECT:
+    key_set_repeat_mask(KEY_MASK(KEY_3) | KEY_MASK(KEY_2)); // 长按连续调整序号
+    screen_delete_select();
+    anim_wipe();
+    break;
+  case UI_WAIT_READY:
+    if (s_ui_op != UI_OP_DELETE) {
+      screen_connecting();
+      anim_wipe();
+      ui_spinner();
+    }
+    user_buffer_len = 0;
+    module_power(true); // 打开FM225的电源，等待开机准备好的消息
+    ui_arm(FM225_READY_MS);
+    break;
+  case UI_WAIT_REPLY: {
+    uint32_t timeout = ui_send_command();
+    if (timeout == 0) {
+      ui_fail();
+      return;
+    }
+    ui_arm(timeout);
+    if (s_ui_op != UI_OP_DELETE) {
+      // 模块计时的倒计时：在应答超时前FM225_REPLY_MARGIN_MS走完
+      progress_start(7, s_ui_deadline - FM225_REPLY_MARGIN_MS, FM225_CMD_TIMEOUT_S * 1000U);
+      ui_spinner();
+    }
+    break;
+  }
+  case UI_RESULT:
+    ui_arm(RESULT_HOLD_MS);
+    anim_wipe(); // 结果界面已在进入前画好
+    anim_blink(0, 16, OLED_WIDTH - 1, 31, RESULT_BLINK_COUNT); // 第2~3页标题行
+    break;
+  case UI_CLOCK:
+    OLED_ClearRows(2, 7);
+    memset(s_big_clock, 0, sizeof(s_big_clock)); // 整行重绘，之后由RTC秒中断每秒刷新
+    OLED_ShowTime(); // 读出当前时间（时间行未变时不重画）
+    show_big_clock();
+    break;
+  }
+}
 
-      } else {
-        face_delete_user(g_delete_id);
-      }
-      while (1) {
+// 返回键：中止当前操作并回到主菜单
+static void ui_abort(void) {
+  module_power(false);
+  swtimer_stop(&s_voice_timer);
+  voice_release_cb(NULL);
+  swtimer_stop(&s_lock_timer);
+  lock_release_cb(NULL);
+  ui_enter(UI_MAIN);
+}
 
-        if (user_buffer[2] == 0X00 && user_buffer[5] == CMD_DELETE_USER &&
-            user_buffer[6] == 0X00) {
+static void ui_on_key(uint8_t key) {
+  if (key == KEY_1) {
+    ui_abort();
+    return;
+  }
+  // 大字时钟下按键先回到主菜单，再按主菜单处理（不需要多按一次）
+  if (s_ui_state == UI_CLOCK) {
+    ui_enter(UI_MAIN);
+  }
 
-          // 重置 user_buffer 和 user_buffer_len
-          user_buffer_len = 0;
-          memset(user_buffer, 0x00, sizeof(user_buffer));
+  switch (s_ui_state) {
+  case UI_MAIN:
+    if (key == KEY_3) {
+      ui_enter(UI_ENROLL_SELECT);
+    } else if (key == KEY_2) {
+      s_ui_op = UI_OP_VERIFY;
+      ui_enter(UI_WAIT_READY);
+    } else if (key == KEY_0) {
+      ui_enter(UI_DELETE_SELECT);
+    }
+    break;
+  case UI_ENROLL_SELECT:
+    if (key == KEY_3) {
+      s_ui_op = UI_OP_ENROLL;
+      ui_enter(UI_WAIT_READY);
+    } else if (key == KEY_2 && g_user_name < 99) {
+      g_user_name++;
+      show_enroll_id();
+    } else if (key == KEY_0 && g_user_name > 1) {
+      g_user_name--;
+      show_enroll_id();
+    }
+    break;
+  case UI_DELETE_SELECT:
+    if (key == KEY_0) {
+      s_ui_op = UI_OP_DELETE;
+      ui_enter(UI_WAIT_READY);
+    } else if (key == KEY_3 && g_delete_id < 99) {
+      g_delete_id++;
+      show_delete_id();
+    } else if (key == KEY_2 && g_delete_id > 0) {
+      g_delete_id--;
+      show_delete_id();
+    }
+    break;
+  default:
+    break; // 等待模块期间只响应返回键
+  }
+}
 
-          // 播放删除成功语音
-          HAL_GPIO_WritePin(IO7_GPIO_Port, IO7_Pin, GPIO_PIN_RESET);
+// 长按：主菜单中长按返回键切换界面语言（按下时已回到主菜单），
+// 保存在备份寄存器中，复位后保持
+static void ui_on_long_key(uint8_t key) {
+  if (key == KEY_1 && s_ui_state == UI_MAIN) {
+    lang_set((lang_t)((lang_get() + 1) % LANG_COUNT));
+    HAL_RTCEx_BKUPWrite(&hrtc, LANG_BKP_REG, lang_get());
+    ui_enter(UI_MAIN);
+  }
+}
 
-          OLED_ClearRows(2, 5); // 清空2~5行
+// 处理模块命令应答
+static void ui_on_reply(const uint8_t *frame, uint16_t len) {
+  uint8_t mid = frame[5];
+  uint8_t result = frame[6];
 
-          OLED_ShowCHinese(32, 2, 4, 0);  // 删
-          OLED_ShowCHinese(48, 2, 5, 0);  // 除
-          OLED_ShowCHinese(64, 2, 16, 0); // 成
-          OLED_ShowCHinese(80, 2, 17, 0); // 功
+  switch (s_ui_op) {
+  case UI_OP_ENROLL:
+    if (mid != CMD_ENROLL_ITG) {
+      return;
+    }
+    if (result == MR_SUCCESS && len > 8 && frame[8] != 0x00) {
+      voice_play(IO1_GPIO_Port, IO1_Pin); // 播放录入成功语音
+      OLED_ShowScreen(SCREEN(SCR_ENROLL_SUCCESS));
+      ui_finish();
+    } else if (result == MR_FAILED_FACE_ENROLLED) {
+      voice_play(IO3_GPIO_Port, IO3_Pin); // 播放人脸已录入语音
+      OLED_ShowScreen(SCREEN(SCR_FACE_ENROLLED));
+      ui_finish();
+    } else {
+      voice_play(IO2_GPIO_Port, IO2_Pin); // 播放录入失败语音
+      ui_fail();
+    }
+    break;
+  case UI_OP_VERIFY:
+    // 验证成功由串口中断快速通道处理（fm225_verified）
+    if (mid == CMD_VERIFY_FACE && result != MR_SUCCESS) {
+      voice_play(IO6_GPIO_Port, IO6_Pin); // 播放验证失败语音
+      ui_fail();
+    }
+    break;
+  case UI_OP_DELETE:
+    if (mid != CMD_DELETE_USER && mid != CMD_DELETE_FACE) {
+      return;
+    }
+    if (result == MR_SUCCESS) {
+      voice_play(IO7_GPIO_Port, IO7_Pin); // 播放删除成功语音
+      OLED_ShowScreen(SCREEN(SCR_DELETE_SUCCESS));
+      ui_finish();
+    } else {
+      ui_fail();
+    }
+    break;
+  }
+}
 
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                            GPIO_PIN_RESET); // 关闭FM225的电源
-        }
+// 处理模块上报的一帧数据
+static void ui_on_frame(const uint8_t *frame, uint16_t len) {
+  if (len < 7) {
+    return;
+  }
 
-        if (user_buffer[2] == 0X00 && user_buffer[5] == CMD_DELETE_FACE &&
-            user_buffer[6] == 0X00) {
+  if (s_ui_state == UI_WAIT_READY) {
+    if (frame[2] == MID_NOTE && frame[5] == NID_READY) {
+      ui_enter(UI_WAIT_REPLY);
+    }
+  } else if (s_ui_state == UI_WAIT_REPLY) {
+    if (frame[2] == MID_NOTE && frame[5] == NID_FACE_STATE) {
+      if (frame[6] == FACE_STATE_NORMAL) {
+        screen_face_state(true);
+      } else if (frame[6] == FACE_STATE_NOFACE) {
+        screen_face_state(false);
+      }
+    } else if (frame[2] == MID_REPLY) {
+      ui_on_reply(frame, len);
+    }
+  }
+}
 
-          // 重置 user_buffer 和 user_buffer_len
-          user_buffer_len = 0;
-          memset(user_buffer, 0x00, sizeof(user_buffer));
+// 状态超时
+static void ui_on_timeout(void) {
+  switch (s_ui_state) {
+  case UI_BOOT:
+    OLED_Init();    // OLED初始化
+    oled_pm_init(); // 正常亮度，开始无操作计时
+#ifdef DEBUG
+    OLED_BenchFullRefresh(); // 整屏刷新耗时对比，结果见oled_stats与跟踪输出
+    OLED_BenchDecode(&scr_lang[0][0], LANG_COUNT * SCR_COUNT); // 界面解码速度（全部语言）
+    {
+      static const char *const bench_text[] = {
+          "2025-09-13 18:45", "库中第12个", "序号：12",
+          "Alexandra Konstantinopoulou-Ng"};
+      OLED_BenchText(bench_text, 4); // 逐条文字绘制耗时
+    }
+#endif
+    clock_invalidate(); // 显存已清零，时间行整行重绘
+    ui_enter(UI_MAIN);
+    break;
+  case UI_WAIT_READY:
+    module_power(false);
+    OLED_ShowScreen(SCREEN(SCR_CONNECT_FAILED));
+    ui_enter(UI_RESULT);
+    break;
+  case UI_WAIT_REPLY:
+    ui_fail();
+    break;
+  case UI_RESULT:
+    ui_enter(UI_MAIN);
+    break;
+  default:
+    break;
+  }
+}
 
-          // 播放删除成功语音
-          HAL_GPIO_WritePin(IO7_GPIO_Port, IO7_Pin, GPIO_PIN_RESET);
+// 主循环事件处理：按键、模块消息、定时器超时、时间刷新
+static void ui_poll(void) {
+  uint8_t frame[RX_BUFF_SIZE];
+  uint16_t len;
+  uint8_t keys, longs;
 
-          OLED_ClearRows(2, 5); // 清空2~5行
+  // 取走中断中产生的按键与模块数据
+  __disable_irq();
+  keys = s_key_pending;
+  s_key_pending = 0;
+  longs = s_key_long;
+  s_key_long = 0;
+  len = user_buffer_len;
+  if (len != 0) {
+    memcpy(frame, user_buffer, len);
+    user_buffer_len = 0;
+  }
+  __enable_irq();
 
-          OLED_ShowCHinese(32, 2, 4, 0);  // 删
-          OLED_ShowCHinese(48, 2, 5, 0);  // 除
-          OLED_ShowCHinese(64, 2, 16, 0); // 成
-          OLED_ShowCHinese(80, 2, 17, 0); // 功
+  // 有按键或模块数据时点亮面板（关屏时GDDRAM保持，不需要重绘）
+  if (keys != 0 || len != 0 || fm225_verified) {
+    oled_pm_activity();
+  }
 
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin,
-                            GPIO_PIN_RESET); // 关闭FM225的电源
-        }
+  if (s_ui_timeout) {
+    s_ui_timeout = false;
+    ui_on_timeout();
+  }
 
-        if (KEY3_PRESSED == 1) {
-          KEY3_PRESSED = 0;
-        }
+  // 验证成功：开锁已在串口中断中完成，这里只做显示
+  if (fm225_verified) {
+    fm225_verified = false;
+    if (s_ui_state == UI_WAIT_REPLY && s_ui_op == UI_OP_VERIFY) {
+      screen_verify_success(fm225_verified_id);
+      ui_finish();
+      screen_user_name(fm225_verified_name);
+    }
+  }
 
-        if (KEY2_PRESSED == 1) {
-          KEY2_PRESSED = 0;
-        }
+  if (len != 0) {
+    ui_on_frame(frame, len);
+  }
 
-        if (KEY0_PRESSED == 1) {
-          KEY0_PRESSED = 0;
-        }
-        if (KEY1_PRESSED == 1) {
-          KEY1_PRESSED = 0;
-          HAL_GPIO_WritePin(IO7_GPIO_Port, IO7_Pin, GPIO_PIN_SET);
-          HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_RESET); // 关闭FM225的电源
-          menu = menu_main;
-          return 0;
-        }
-      }
+  for (uint8_t key = 0; key < KEY_NUM; key++) {
+    if (keys & KEY_MASK(key)) {
+      ui_on_key(key);
     }
-    if (KEY3_PRESSED == 1) {
-      KEY3_PRESSED = 0;
-      if (g_delete_id < 99) {
-        g_delete_id++;
-        OLED_ShowNum(72, 4, g_delete_id, 2, 16, 0);
-      }
-    }
-    if (KEY2_PRESSED == 1) {
-      KEY2_PRESSED = 0;
-      if (g_delete_id > 0) {
-        g_delete_id--;
-        OLED_ShowNum(72, 4, g_delete_id, 2, 16, 0);
-      }
+    if (longs & KEY_MASK(key)) {
+      ui_on_long_key(key);
     }
-    if (KEY1_PRESSED == 1) {
-      KEY1_PRESSED = 0;
-      HAL_GPIO_WritePin(FM225_CTL_GPIO_Port, FM225_CTL_Pin, GPIO_PIN_RESET);
-      menu = menu_main;
-      return 0;
+  }
+
+  if (s_clock_dirty && s_ui_state != UI_BOOT) {
+    s_clock_dirty = false;
+    OLED_ShowTime();
+    if (s_ui_state == UI_CLOCK) {
+      show_big_clock();
     }
   }
+
+  // 本轮绘制的内容一次性写入面板（只发送有改动的列）
+  if (s_ui_state != UI_BOOT) {
+    progress_poll();
+    anim_poll();
+    oled_pm_poll();
+    ui_idle_poll();
+    OLED_Refresh();
+    marquee_poll();
+  }
 }
+
 void OLED_ShowTime(void) {
-  char buf[50]; // 存放 "YYYY-MM-DD HH:MM"
+  char buf[sizeof(s_clock_text)]; // "YYYY-MM-DD HH:MM"
+  char *p = buf;
+  uint8_t i;
 
   /* 获取 RTC 当前时间和日期 */
+  s_clock_minute = RTC_GetCounter() / 60U;
   RTC_GetTime();
 
-  /* 格式化日期 + 时分 */
-  memset(buf, 0, sizeof(buf));
-  sprintf(buf, "%04d-%02d-%02d %02d:%02d", date_info[0], date_info[1],
-          date_info[2], date_info[3], date_info[4]);
+  /* 格式化日期 + 时分（fmt.h，不引入sprintf） */
+  p = fmt_u32(p, date_info[0], 4, '0', 10);
+  *p++ = '-';
+  p = fmt_u32(p, date_info[1], 2, '0', 10);
+  *p++ = '-';
+  p = fmt_u32(p, date_info[2], 2, '0', 10);
+  *p++ = ' ';
+  p = fmt_u32(p, date_info[3], 2, '0', 10);
+  *p++ = ':';
+  fmt_u32(p, date_info[4], 2, '0', 10);
+
+  /* 显示在 OLED 第一行：只重画与上次不同的字符 */
+  for (i = 0; buf[i] != '\0'; i++) {
+    if (buf[i] != s_clock_text[i]) {
+      OLED_ShowChar(i * 8, 0, buf[i], 16, 0);
+      s_clock_text[i] = buf[i];
+    }
+  }
+}
 
-  /* 显示在 OLED 第一行 */
-  OLED_ShowString(0, 0, buf, 16, 0);
+// 大字时钟：时分秒2倍放大显示在第3~6页，只重画与上次不同的字符
+// （每秒通常只有秒的个位变化，16列×4页，单次刷新约1.5ms，远短于一帧）
+static void show_big_clock(void) {
+  char buf[sizeof(s_big_clock)]; // "HH:MM:SS"，由OLED_ShowTime刚读出的date_info格式化
+  char *p = buf;
+  uint8_t i;
+
+  p = fmt_u32(p, date_info[3], 2, '0', 10);
+  *p++ = ':';
+  p = fmt_u32(p, date_info[4], 2, '0', 10);
+  *p++ = ':';
+  fmt_u32(p, date_info[5], 2, '0', 10);
+
+  for (i = 0; buf[i] != '\0'; i++) {
+    if (buf[i] != s_big_clock[i]) {
+      char ch[2] = {buf[i], '\0'};
+      OLED_DrawText2X(i * 16, 24, ch, OLED_ALIGN_LEFT, OLED_COPY);
+      s_big_clock[i] = buf[i];
+    }
+  }
+}
+
+// 无操作界面切换：主菜单在面板调暗后换成大字时钟，关屏后换回主菜单
+// （关屏期间不再每秒唤醒，重新点亮时直接是主菜单）
+static void ui_idle_poll(void) {
+  oled_pm_state_t pm = oled_pm_state();
+  if (s_ui_state == UI_MAIN && pm == OLED_PM_DIM) {
+    ui_enter(UI_CLOCK);
+  } else if (s_ui_state == UI_CLOCK && pm == OLED_PM_OFF) {
+    ui_enter(UI_MAIN);
+  }
+}
+
+// 时间行整行重绘（显存被清空或面板重新上电后调用）
+static void clock_invalidate(void) {
+  memset(s_clock_text, 0, sizeof(s_clock_text));
+  s_clock_minute = UINT32_MAX;
+  s_clock_dirty = true;
 }
 
 /* 定时器中断回调函数 */
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
   if (htim->Instance == TIM1) {
-    /* 停止定时器 */
-    HAL_TIM_Base_Stop_IT(&htim1);
-
-    /* 读取按键状态 */
-    if (HAL_GPIO_ReadPin(KEY0_GPIO_Port, KEY0_Pin) == GPIO_PIN_RESET) {
-      KEY0_PRESSED = 1;
-    }
-    if (HAL_GPIO_ReadPin(KEY1_GPIO_Port, KEY1_Pin) == GPIO_PIN_RESET) {
-      KEY1_PRESSED = 1;
-    }
-    if (HAL_GPIO_ReadPin(KEY2_GPIO_Port, KEY2_Pin) == GPIO_PIN_RESET) {
-      KEY2_PRESSED = 1;
-    }
-    if (HAL_GPIO_ReadPin(KEY3_GPIO_Port, KEY3_Pin) == GPIO_PIN_RESET) {
-      KEY3_PRESSED = 1;
-    }
+    key_scan_tick(); // 按键周期扫描
   }
 }
 // 外部中断回调函数
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
-  // 检查是否为有效按键引脚
-  if (GPIO_Pin == KEY0_Pin || GPIO_Pin == KEY1_Pin || GPIO_Pin == KEY2_Pin ||
-      GPIO_Pin == KEY3_Pin) {
-    // 清除定时器计数并启动定时器
-    __HAL_TIM_SET_COUNTER(&htim1, 0);
-    HAL_TIM_Base_Start_IT(&htim1);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) { key_exti_callback(GPIO_Pin); }
+// 按键事件回调函数：按下、连发与长按事件交给主循环处理
+void key_event_callback(const key_event_t *event) {
+  TRACE(TRACE_EV_KEY, event->key, event->type);
+  if (event->type == KEY_EVENT_PRESS || event->type == KEY_EVENT_REPEAT) {
+    s_key_pending |= KEY_MASK(event->key);
+  } else if (event->type == KEY_EVENT_LONG) {
+    s_key_long |= KEY_MASK(event->key);
   }
 }
 // UART接收事件回调函数
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
   if (huart->Instance == USART1) {
+    // 验证成功应答（仅限已发出的验证命令）在中断中立即开锁，先于拷贝与重启DMA
+    fm225_fast_path(RX_BUFFER, Size);
+    TRACE(TRACE_EV_UART_RX, Size, ((uint32_t)RX_BUFFER[2] << 8) | RX_BUFFER[5]);
 
     HAL_UART_DMAStop(&huart1);
 
@@ -830,8 +848,36 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
     HAL_UARTEx_ReceiveToIdle_DMA(&huart1, RX_BUFFER, RX_BUFF_SIZE);
   }
 }
-// RTC秒中断回调函数
-void HAL_RTCEx_RTCEventCallback(RTC_HandleTypeDef *hrtc) { OLED_ShowTime(); }
+// 低功耗空闲判断：未在等待模块且无待处理事件时允许进入Stop模式
+bool power_app_is_idle(void) {
+  if (s_ui_state == UI_BOOT || s_ui_state == UI_WAIT_READY ||
+      s_ui_state == UI_WAIT_REPLY) {
+    return false;
+  }
+  return s_key_pending == 0 && s_key_long == 0 && !s_ui_timeout && !s_clock_dirty &&
+         user_buffer_len == 0 && !fm225_verified && !OLED_Busy() &&
+         !oled_pm_busy() && !marquee_busy() && !anim_busy();
+}
+// 验证成功回调函数（串口中断上下文）：开锁并播放验证成功语音
+void fm225_verify_success_callback(uint16_t user_id) {
+  (void)user_id;
+  LOCK_GPIO_Port->BSRR = LOCK_Pin; // 开锁
+  swtimer_start(&s_lock_timer, UNLOCK_HOLD_MS, lock_release_cb, NULL);
+  voice_play(IO5_GPIO_Port, IO5_Pin); // 播放验证成功语音
+}
+// Stop唤醒时刻：大字时钟显示秒，每秒唤醒；其余界面时间只到分钟，整分唤醒
+uint32_t power_app_wakeup(uint32_t counter) {
+  if (s_ui_state == UI_CLOCK) {
+    return counter + 1U;
+  }
+  return counter - (counter % 60U) + 60U;
+}
+// RTC秒中断：时间行只到分钟，分钟未变且不在大字时钟界面时不唤起主循环重绘
+void HAL_RTCEx_RTCEventCallback(RTC_HandleTypeDef *hrtc) {
+  if (s_ui_state == UI_CLOCK || RTC_GetCounter() / 60U != s_clock_minute) {
+    s_clock_dirty = true;
+  }
+}
 /* USER CODE END 4 */
 
 /**
@@ -0,0 +1,111 @@
+#include "marquee.h"
+#include "swtimer.h"
+
+static char s_text[MARQUEE_TEXT_MAX + 1]; // 显示的文字（'\0'结尾）
+static uint16_t s_seg = 0;                // 当前段在s_text中的起始字节
+static uint16_t s_seg_len = 0;            // 当前段字节数
+static uint8_t s_page = 0;                // 起始页（文字占两页）
+static bool s_active = false;             // 文字超宽，正在分段滚动
+static bool s_restart = false; // 当前段已画入显存，写入面板后开始滚动
+static volatile bool s_lap_due = false; // 滚完一圈，换下一段
+static swtimer_t s_lap_timer;
+
+static void marquee_lap_cb(void *arg) {
+  (void)arg;
+  s_lap_due = true;
+}
+
+// 将当前段左对齐画入显存，其余列清空
+static void marquee_draw(void) {
+  char seg[MARQUEE_TEXT_MAX + 1];
+
+  s_seg_len = OLED_TextFit(&s_text[s_seg], OLED_WIDTH - MARQUEE_GAP);
+  memcpy(seg, &s_text[s_seg], s_seg_len);
+  seg[s_seg_len] = '\0';
+  OLED_ClearRows(s_page, s_page + 1);
+  OLED_ShowText(0, s_page, seg, 0);
+  s_restart = true;
+}
+
+/**
+ * @brief 在指定两页显示一行文字，放不下时用硬件滚动分段轮播
+ * @param page 起始页（0~6）
+ * @param text UTF-8文字，不要求'\0'结尾
+ * @param len  最多取的字节数（超过MARQUEE_TEXT_MAX截断，遇'\0'提前结束）
+ * @note  放得下时居中静止显示；切换界面前须调用marquee_stop
+ */
+void marquee_start(uint8_t page, const char *text, uint16_t len) {
+  uint16_t n = 0;
+  uint16_t width;
+
+  marquee_stop();
+  while (n < len && n < MARQUEE_TEXT_MAX && text[n] != '\0') {
+    s_text[n] = text[n];
+    n++;
+  }
+  s_text[n] = '\0';
+  s_page = page;
+  s_seg = 0;
+
+  width = OLED_TextWidth(s_text);
+  if (width <= OLED_WIDTH) {
+    OLED_ClearRows(page, page + 1);
+    OLED_ShowText((OLED_WIDTH - width) / 2, page, s_text, 0);
+    return;
+  }
+  s_active = true;
+  marquee_draw();
+}
+
+/**
+ * @brief 停止滚动，被滚动的页在下次OLED_Refresh时按显存内容重写
+ * @note  停止命令排不进显示队列时面板仍在滚动，由OLED_Refresh在有改动时重试
+ */
+void marquee_stop(void) {
+  swtimer_stop(&s_lap_timer);
+  s_lap_due = false;
+  s_active = false;
+  s_restart = false;
+  OLED_ScrollStop();
+}
+
+/**
+ * @brief 主循环调用（在OLED_Refresh之后）：开始滚动、换段
+ * @note  滚动期间禁止写GDDRAM，因此每段都是先停止滚动、刷新、再重新开始
+ */
+void marquee_poll(void) {
+  if (!s_active) {
+    return;
+  }
+
+  if (s_lap_due) {
+    s_lap_due = false;
+    OLED_ScrollStop();
+    s_seg += s_seg_len;
+    if (s_text[s_seg] == '\0') {
+      s_seg = 0;
+    }
+    marquee_draw();
+    return;
+  }
+
+  if (s_restart) {
+    // 当前段已完整写入面板；开始滚动的命令排不进显示队列时下次重试
+    if (!OLED_Busy() &&
+        OLED_ScrollStart(0x27, s_page, s_page + 1, MARQUEE_INTERVAL)) {
+      swtimer_start(&s_lap_timer, MARQUEE_LAP_MS, marquee_lap_cb, NULL);
+      s_restart = false;
+    }
+  } else if (!OLED_Scrolling()) {
+    // 其他内容（如时间行）刷新时停止了滚动：当前段重写后从头滚动
+    swtimer_stop(&s_lap_timer);
+    s_restart = true;
+  }
+}
+
+/**
+ * @brief 是否有待执行的滚动操作（有则主循环不应进入Stop）
+ */
+bool marquee_busy(void) {
+  return s_lap_due || (s_active && (s_restart || !OLED_Scrolling()));
+}
@@ -5,6 +5,14 @@
  *      Author: Unicorn_Li
  */
 #include "oled.h"
+#include "dwt.h"
+#include "fmt.h"
+#include "font_cjk.h"
+#include "oled_i2c.h"
+#include "oled_mirror.h"
+#include "oled_queue.h"
+#include "rle.h"
+#include "trace.h"
 
 /**********************************************************
  * 初始化命令,根据芯片手册书写，详细步骤见上图以及注意事项
@@ -14,40 +22,395 @@ uint8_t CMD_Data[] = {
 
     0x12, 0x81, 0xCF, 0xD9, 0xF1, 0xDB, 0x40, 0xA4, 0xA6, 0x8D, 0x14,
 
+    0x20, 0x00, // 水平寻址模式：按列/页窗口连续写入，到列尾自动换页
+
+    0x2E, // 停止滚动（MCU复位而面板未断电时可能仍在滚动）
+
     0xAF};
 
+volatile oled_stats_t oled_stats = {0};
+
+// 显存：8页×128列，每字节为一列中纵向8个像素（低位在上），与面板GDDRAM布局一致
+static uint8_t OLED_GRAM[OLED_PAGES][OLED_WIDTH];
+// 每页待刷新的列范围[lo, hi]，lo > hi表示该页与面板一致
+static uint8_t s_dirty_lo[OLED_PAGES];
+static uint8_t s_dirty_hi[OLED_PAGES];
+
+// 双缓冲：OLED_GRAM为后台缓冲，绘图只改它；OLED_Refresh把改动区域复制到显示队列的
+// 数据区（前台缓冲，发送期间不再变化）并追加窗口命令，由DMA完成中断依次发送。
+// 一次OLED_Refresh提交的窗口为一帧，这一帧全部发完（帧尾标记执行）之前不提交下一帧，
+// 面板上不会出现两帧混合或绘制到一半的内容
+// 每个窗口在数据之外的总线开销（字节）：窗口命令一次传输（地址、控制字节与6字节命令）
+// 加数据传输的地址与控制字节；相邻页合并后多发的字节不超过它时合并为一个窗口
+#define OLED_WINDOW_OVERHEAD 10
+// 硬件滚动的页范围，s_scroll_first == OLED_PAGES表示未滚动
+static uint8_t s_scroll_first = OLED_PAGES;
+static uint8_t s_scroll_last = 0;
+// OLED_Refresh合并出的一个窗口：列x0~x1、页p0~p1
+typedef struct {
+  uint8_t x0, x1, p0, p1;
+} oled_window_t;
+// 已提交的一帧还在发送（提交时置位，帧尾标记执行时清除）
+static volatile bool s_frame_pending = false;
+// 刷新只发送列0~s_refresh_x1（擦除过渡逐步放开），右侧的改动保留到放开后再发
+static uint8_t s_refresh_x1 = OLED_WIDTH - 1;
+
+/**
+ * @function: oled_mark_dirty
+ * @description: 将一页中的列范围并入待刷新区域（无改动时lo=OLED_WIDTH、hi=0）
+ */
+static void oled_mark_dirty(uint8_t page, uint8_t x0, uint8_t x1) {
+  if (s_dirty_lo[page] > x0)
+    s_dirty_lo[page] = x0;
+  if (s_dirty_hi[page] < x1)
+    s_dirty_hi[page] = x1;
+}
+
+/**
+ * @function: oled_gram_write
+ * @description: 写显存一个字节，内容变化时才标记为待刷新；超出屏幕的坐标直接丢弃
+ */
+static void oled_gram_write(uint8_t page, uint8_t x, uint8_t data) {
+  if (page >= OLED_PAGES || x >= OLED_WIDTH)
+    return;
+  if (OLED_GRAM[page][x] != data) {
+    OLED_GRAM[page][x] = data;
+    oled_mark_dirty(page, x, x);
+  }
+}
+
+/**
+ * @function: oled_gram_copy_row
+ * @description: 将一行数据复制到显存，只把首尾不同字节之间的列标记为待刷新
+ */
+static void oled_gram_copy_row(uint8_t page, const uint8_t *src) {
+  uint8_t *row = OLED_GRAM[page];
+  uint8_t x0 = 0, x1 = OLED_WIDTH - 1;
+
+  while (x0 < OLED_WIDTH && row[x0] == src[x0])
+    x0++;
+  if (x0 == OLED_WIDTH)
+    return;
+  while (row[x1] == src[x1])
+    x1--;
+  memcpy(&row[x0], &src[x0], x1 - x0 + 1);
+  oled_mark_dirty(page, x0, x1);
+}
+
+/**
+ * @function: oled_gram_fill
+ * @description: 将若干页整行填充为同一数据
+ */
+static void oled_gram_fill(uint8_t start_page, uint8_t end_page, uint8_t data) {
+  uint8_t i, n;
+  for (i = start_page; i <= end_page; i++)
+    for (n = 0; n < OLED_WIDTH; n++)
+      oled_gram_write(i, n, data);
+}
+
 /**
  * @function: void OLED_Init(void)
- * @description: OLED初始化
+ * @description: OLED初始化（上电稳定等待由调用者通过软件定时器完成）
  * @return {*}
  */
 void OLED_Init(void) {
-  HAL_Delay(200);
+  OLED_WR_CMDS(CMD_Data, sizeof(CMD_Data)); // 初始化命令一次发送（上电后队列为空）
+
+  // 上电后面板GDDRAM内容不确定，显存清零并整屏标记，下次刷新时清屏
+  memset(OLED_GRAM, 0x00, sizeof(OLED_GRAM));
+  s_scroll_first = OLED_PAGES;
+  OLED_Invalidate();
+}
+
+/**
+ * @function: void OLED_Invalidate(void)
+ * @description: 整屏标记为待刷新（面板内容被硬件滚动等操作改变后调用）
+ * @return {*}
+ */
+void OLED_Invalidate(void) {
+  uint8_t i;
+  for (i = 0; i < OLED_PAGES; i++) {
+    s_dirty_lo[i] = 0;
+    s_dirty_hi[i] = OLED_WIDTH - 1;
+  }
+}
+
+/**
+ * @function: oled_window_cmd
+ * @description: 生成列/页窗口命令（水平寻址模式下数据在窗口内逐列、逐页连续写入）
+ */
+static void oled_window_cmd(uint8_t *cmd, uint8_t x0, uint8_t x1, uint8_t p0,
+                            uint8_t p1) {
+  cmd[0] = 0x21; // 设置列地址范围
+  cmd[1] = x0;
+  cmd[2] = x1;
+  cmd[3] = 0x22; // 设置页地址范围
+  cmd[4] = p0;
+  cmd[5] = p1;
+}
+
+/**
+ * @function: oled_gram_dirty
+ * @description: 显存中是否有尚未追加到显示队列的改动
+ */
+static bool oled_gram_dirty(void) {
+  uint8_t i;
+  for (i = 0; i < OLED_PAGES; i++)
+    if (s_dirty_lo[i] <= s_dirty_hi[i])
+      return true;
+  return false;
+}
+
+/**
+ * @function: oled_window_len
+ * @description: 窗口数据字节数
+ */
+static uint16_t oled_window_len(const oled_window_t *w) {
+  return (uint16_t)(w->x1 - w->x0 + 1) * (w->p1 - w->p0 + 1);
+}
+
+/**
+ * @function: oled_queue_window
+ * @description: 将一个窗口（窗口命令+数据）追加到显示队列，这些页不再待刷新
+ * @note  数据按行拼接复制到队列数据区，之后绘图不影响这次发送的内容；
+ *        调用前须确认操作环与数据区能放下（见OLED_Refresh）
+ */
+static void oled_queue_window(const oled_window_t *w) {
+  uint8_t cmd[6];
+  uint8_t x0 = w->x0, x1 = w->x1, p0 = w->p0, p1 = w->p1;
+  uint8_t width = x1 - x0 + 1;
+  uint16_t len = oled_window_len(w);
+  uint8_t *dst;
+  uint8_t i;
+
+  dst = oled_queue_reserve(len);
+  if (width == OLED_WIDTH)
+    memcpy(dst, &OLED_GRAM[p0][0], len); // 整行宽度在显存中本就连续
+  else
+    for (i = p0; i <= p1; i++)
+      memcpy(&dst[(i - p0) * width], &OLED_GRAM[i][x0], width);
+  oled_window_cmd(cmd, x0, x1, p0, p1);
+  oled_queue_write(OLED_CTRL_CMD, cmd, sizeof(cmd));
+  oled_queue_commit(OLED_CTRL_DATA);
+  OLED_MIRROR(p0, p1, x0, x1); // 面板镜像：记录写入面板的范围
+  for (i = p0; i <= p1; i++) {
+    if (s_dirty_hi[i] > x1) {
+      s_dirty_lo[i] = x1 + 1; // 刷新范围限制之外的部分
+    } else {
+      s_dirty_lo[i] = OLED_WIDTH;
+      s_dirty_hi[i] = 0;
+    }
+  }
+}
+
+/**
+ * @function: oled_frame_done
+ * @description: 帧尾标记回调（oled_queue_poll中执行）：这一帧已全部发送，可以提交下一帧
+ */
+static void oled_frame_done(void *arg) {
+  (void)arg;
+  s_frame_pending = false;
+}
+
+/**
+ * @function: void OLED_Refresh(void)
+ * @description: 将显存中有改动的区域写入面板，绘图函数只修改显存，需调用本函数才会显示
+ * @note  相邻改动页合并后多发的字节不超过窗口开销时合并为一个窗口，否则各自成窗口；
+ *        本次的全部窗口作为一帧复制到显示队列后立即返回，由DMA完成中断连续发送；
+ *        上一帧未发完或队列放不下整帧时不提交，改动留在显存中，之后的调用再作为
+ *        完整的一帧提交
+ * @note  滚动期间禁止写GDDRAM，有改动时先停止滚动并重发被滚动的页
+ * @return {*}
+ */
+void OLED_Refresh(void) {
+  oled_window_t win[OLED_PAGES];
+  uint8_t i, windows = 0;
+  uint8_t x0 = 0, x1 = 0, p0 = OLED_PAGES;
+  uint16_t bytes = 0;
+
+  oled_i2c_poll(); // DMA传输超时时在这里中止并恢复总线
+  oled_queue_poll(); // 上一帧已发完时在这里执行帧尾标记
+  if (oled_i2c_backoff())
+    return; // 面板故障暂停发送中：改动保留，暂停结束后再发（不等待、不占用总线）
+  if (oled_queue_take_error())
+    OLED_Invalidate(); // 有传输出错时面板内容未知，整屏重发
+  if (s_scroll_first < OLED_PAGES && oled_gram_dirty() && !OLED_ScrollStop())
+    return; // 停止滚动的命令排不进队列：滚动期间不能写GDDRAM，下次刷新重试
+
+  if (s_frame_pending) {
+    oled_stats.frame_deferred++;
+    return;
+  }
+
+  for (i = 0; i <= OLED_PAGES; i++) {
+    uint8_t lo = 0, hi = 0;
+    bool dirty = false;
+    if (i < OLED_PAGES) {
+      lo = s_dirty_lo[i];
+      hi = s_dirty_hi[i] < s_refresh_x1 ? s_dirty_hi[i] : s_refresh_x1;
+      dirty = lo <= hi;
+    }
+    if (p0 < OLED_PAGES) {
+      if (dirty) {
+        uint8_t mx0 = lo < x0 ? lo : x0;
+        uint8_t mx1 = hi > x1 ? hi : x1;
+        uint16_t merged = (uint16_t)(mx1 - mx0 + 1) * (i - p0 + 1);
+        uint16_t separate = (uint16_t)(x1 - x0 + 1) * (i - p0) +
+                            (hi - lo + 1) + OLED_WINDOW_OVERHEAD;
+        if (merged <= separate) {
+          x0 = mx0;
+          x1 = mx1;
+          continue;
+        }
+      }
+      win[windows].x0 = x0;
+      win[windows].x1 = x1;
+      win[windows].p0 = p0;
+      win[windows].p1 = i - 1;
+      bytes += oled_window_len(&win[windows]);
+      windows++;
+      p0 = OLED_PAGES;
+    }
+    if (dirty) {
+      p0 = i;
+      x0 = lo;
+      x1 = hi;
+    }
+  }
+
+  if (windows == 0)
+    return;
+  // 每个窗口为命令与数据两条操作，另加帧尾标记；放不下整帧时一条也不追加
+  if (!oled_queue_room(windows * 2 + 1) || !oled_queue_room_arena(windows, bytes))
+    return;
+  for (i = 0; i < windows; i++)
+    oled_queue_window(&win[i]);
+  // 帧尾标记：标记前置位，队列已空闲时标记会在oled_queue_fence中直接执行
+  s_frame_pending = true;
+  oled_queue_fence(oled_frame_done, NULL); // 上面已确认有空位
+  oled_stats.frame_count++;
+}
 
-  uint8_t i = 0;
-  for (i = 0; i < 23; i++) {
-    OLED_WR_CMD(CMD_Data[i]);
+/**
+ * @function: void OLED_RefreshLimit(uint8_t x1)
+ * @description: 限制OLED_Refresh只发送列0~x1，右侧的改动留在显存中，面板保持原内容
+ * @param {uint8_t} x1 最右发送列；OLED_WIDTH - 1为不限制
+ * @note  擦除过渡（anim.c）逐帧增大x1，新界面从左向右覆盖旧界面
+ * @return {*}
+ */
+void OLED_RefreshLimit(uint8_t x1) {
+  s_refresh_x1 = x1 < OLED_WIDTH ? x1 : OLED_WIDTH - 1;
+}
+
+/**
+ * @function: void OLED_ReadGram(uint8_t page, uint8_t x0, uint8_t len, uint8_t *dst)
+ * @description: 读出显存一页中的连续列（面板镜像oled_mirror.c发送改动时使用）
+ * @param {uint8_t} page 页
+ * @param {uint8_t} x0 起始列
+ * @param {uint8_t} len 列数（x0 + len不超过OLED_WIDTH）
+ * @param {uint8_t} *dst 输出
+ * @return {*}
+ */
+void OLED_ReadGram(uint8_t page, uint8_t x0, uint8_t len, uint8_t *dst) {
+  memcpy(dst, &OLED_GRAM[page][x0], len);
+}
+
+/**
+ * @function: void OLED_BenchFullRefresh(void)
+ * @description: 整屏刷新耗时对比（阻塞，调试用）：逐页定位+逐字节写入 与 单窗口连续写入
+ * @note  结果记录在oled_stats.full_legacy_us/full_stream_us并输出跟踪事件
+ * @return {*}
+ */
+void OLED_BenchFullRefresh(void) {
+  static const uint8_t page_mode[] = {0x20, 0x02};
+  static const uint8_t horizontal_mode[] = {0x20, 0x00};
+  uint8_t cmd[6];
+  uint8_t i, n;
+  uint32_t t0;
+
+  // 原实现：页寻址模式，每页3条定位命令，每字节一次I2C传输
+  oled_queue_flush(); // 队列排空后下面的命令必能排入
+  OLED_WR_CMDS(page_mode, sizeof(page_mode));
+  t0 = dwt_cycles();
+  for (i = 0; i < OLED_PAGES; i++) {
+    OLED_WR_CMD(0xb0 + i);
+    OLED_WR_CMD(0x00);
+    OLED_WR_CMD(0x10);
+    for (n = 0; n < OLED_WIDTH; n++)
+      OLED_WR_DATA(OLED_GRAM[i][n]);
   }
+  oled_stats.full_legacy_us = dwt_cycles_to_us(dwt_cycles() - t0);
+
+  // 水平寻址模式：一条窗口命令 + 1024字节一次传输
+  OLED_WR_CMDS(horizontal_mode, sizeof(horizontal_mode));
+  t0 = dwt_cycles();
+  oled_window_cmd(cmd, 0, OLED_WIDTH - 1, 0, OLED_PAGES - 1);
+  OLED_WR_CMDS(cmd, sizeof(cmd));
+  OLED_WR_DATAS(&OLED_GRAM[0][0], sizeof(OLED_GRAM));
+  oled_stats.full_stream_us = dwt_cycles_to_us(dwt_cycles() - t0);
+
+  TRACE(TRACE_EV_OLED_BENCH, oled_stats.full_legacy_us,
+        oled_stats.full_stream_us);
+}
+
+/**
+ * @function: bool OLED_Busy(void)
+ * @description: 是否有尚未写入面板的内容（显示队列未排空、有传输出错待重发或显存有改动）
+ * @note  面板故障暂停发送期间只看队列：待发内容推迟到之后的刷新，不阻止进入Stop
+ * @return {bool}
+ */
+bool OLED_Busy(void) {
+  if (!oled_queue_idle())
+    return true;
+  if (oled_i2c_backoff())
+    return false;
+  return oled_queue_failed() || oled_gram_dirty();
 }
 
 /**
  * @function: void OLED_WR_CMD(uint8_t cmd)
- * @description: 向设备写控制命令
+ * @description: 向设备写控制命令（阻塞，先等显示队列中的传输发送完）
  * @param {uint8_t} cmd 芯片手册规定的命令
  * @return {*}
  */
 void OLED_WR_CMD(uint8_t cmd) {
-  HAL_I2C_Mem_Write(&hi2c1, 0x78, 0x00, I2C_MEMADD_SIZE_8BIT, &cmd, 1, 0x100);
+  oled_queue_flush();
+  oled_i2c_write(OLED_CTRL_CMD, &cmd, 1);
+}
+
+/**
+ * @function: bool OLED_WR_CMDS(const uint8_t *cmds, uint16_t len)
+ * @description: 在一次I2C传输中连续写入多条命令（含参数）
+ * @param {const uint8_t *} cmds 命令列表（复制到显示队列，调用返回后即可复用）
+ * @param {uint16_t} len 字节数
+ * @note  不等待发送：追加到显示队列，与之前追加的窗口数据按顺序发出
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
+ */
+bool OLED_WR_CMDS(const uint8_t *cmds, uint16_t len) {
+  return oled_queue_write(OLED_CTRL_CMD, cmds, len);
 }
 
 /**
  * @function: void OLED_WR_DATA(uint8_t data)
- * @description: 向设备写控制数据
+ * @description: 向设备写控制数据（阻塞，先等显示队列中的传输发送完）
  * @param {uint8_t} data 数据
  * @return {*}
  */
 void OLED_WR_DATA(uint8_t data) {
-  HAL_I2C_Mem_Write(&hi2c1, 0x78, 0x40, I2C_MEMADD_SIZE_8BIT, &data, 1, 0x100);
+  oled_queue_flush();
+  oled_i2c_write(OLED_CTRL_DATA, &data, 1);
+}
+
+/**
+ * @function: void OLED_WR_DATAS(const uint8_t *data, uint16_t len)
+ * @description: 在一次I2C传输中连续写入多字节显存数据（阻塞，先等显示队列中的传输发送完）
+ * @param {const uint8_t *} data 数据
+ * @param {uint16_t} len 字节数
+ * @return {*}
+ */
+void OLED_WR_DATAS(const uint8_t *data, uint16_t len) {
+  oled_queue_flush();
+  oled_i2c_write(OLED_CTRL_DATA, data, len);
 }
 
 /**
@@ -56,32 +419,14 @@ void OLED_WR_DATA(uint8_t data) {
 
  * @return {*}
  */
-void OLED_On(void) {
-  uint8_t i, n;
-  for (i = 0; i < 8; i++) {
-    OLED_WR_CMD(0xb0 + i); // 设置页地址（0~7）
-    OLED_WR_CMD(0x00);     // 设置显示位置—列低地址
-    OLED_WR_CMD(0x10);     // 设置显示位置—列高地址
-    for (n = 0; n < 128; n++)
-      OLED_WR_DATA(1);
-  }
-}
+void OLED_On(void) { oled_gram_fill(0, OLED_PAGES - 1, 1); }
 
 /**
  * @function: OLED_Clear(void)
  * @description: 清屏,整个屏幕是黑色的!和没点亮一样!!!
  * @return {*}
  */
-void OLED_Clear(void) {
-  uint8_t i, n;
-  for (i = 0; i < 8; i++) {
-    OLED_WR_CMD(0xb0 + i); // 设置页地址（0~7）
-    OLED_WR_CMD(0x00);     // 设置显示位置—列低地址
-    OLED_WR_CMD(0x10);     // 设置显示位置—列高地址
-    for (n = 0; n < 128; n++)
-      OLED_WR_DATA(0);
-  }
-}
+void OLED_Clear(void) { oled_gram_fill(0, OLED_PAGES - 1, 0); }
 
 /**
  * @function: OLED_ClearRows
@@ -91,68 +436,105 @@ void OLED_Clear(void) {
  */
 void OLED_ClearRows(uint8_t start_page, uint8_t end_page)
 {
-    uint8_t i, n;
-
     if (start_page > 7) start_page = 7;
     if (end_page > 7) end_page = 7;
     if (start_page > end_page) return; // 参数错误直接返回
 
-    for (i = start_page; i <= end_page; i++)
-    {
-        OLED_WR_CMD(0xB0 + i); // 设置页地址
-        OLED_WR_CMD(0x00);     // 列低地址
-        OLED_WR_CMD(0x10);     // 列高地址
-
-        for (n = 0; n < 128; n++)
-            OLED_WR_DATA(0x00); // 清空数据
-    }
+    oled_gram_fill(start_page, end_page, 0x00); // 清空数据
 }
 
 /**
- * @function: void OLED_Display_On(void)
+ * @function: bool OLED_Display_On(void)
  * @description: 开启OLED显示
- * @return {*}
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
  */
-void OLED_Display_On(void) {
-  OLED_WR_CMD(0X8D); // SET DCDC命令
-  OLED_WR_CMD(0X14); // DCDC ON
-  OLED_WR_CMD(0XAF); // DISPLAY ON,打开显示
+bool OLED_Display_On(void) {
+  static const uint8_t cmds[] = {
+      0X8D, // SET DCDC命令
+      0X14, // DCDC ON
+      0XAF, // DISPLAY ON,打开显示
+  };
+  return OLED_WR_CMDS(cmds, sizeof(cmds));
 }
 
 /**
- * @function: void OLED_Display_Off(void)
+ * @function: bool OLED_Display_Off(void)
  * @description: 关闭OLED显示
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
+ */
+bool OLED_Display_Off(void) {
+  static const uint8_t cmds[] = {
+      0X8D, // SET DCDC命令
+      0X10, // DCDC OFF
+      0XAE, // DISPLAY OFF，关闭显示
+  };
+  return OLED_WR_CMDS(cmds, sizeof(cmds));
+}
+
+/**
+ * @function: void OLED_ShowScreen(const oled_screen_t *scr)
+ * @description: 显示预渲染界面：整页替换显存中界面覆盖的页，动态内容在之后叠加
+ * @param {const oled_screen_t *} scr 界面（scr_*，见screens.h）
  * @return {*}
  */
-void OLED_Display_Off(void) {
-  OLED_WR_CMD(0X8D); // SET DCDC命令
-  OLED_WR_CMD(0X10); // DCDC OFF
-  OLED_WR_CMD(0XAE); // DISPLAY OFF，关闭显示
+void OLED_ShowScreen(const oled_screen_t *scr) {
+  static uint8_t row[OLED_WIDTH];
+  const uint8_t *src = scr->data;
+  uint8_t i;
+
+  for (i = scr->first_page; i <= scr->last_page && i < OLED_PAGES; i++) {
+    if (scr->rle_size != 0) {
+      src += rle_decode(src, row, OLED_WIDTH); // 逐行解码后与显存比较
+      oled_gram_copy_row(i, row);
+    } else {
+      oled_gram_copy_row(i, src);
+      src += OLED_WIDTH;
+    }
+  }
 }
 
 /**
- * @function: void OLED_Set_Pos(uint8_t x, uint8_t y)
- * @description: 坐标设置
- * @param {uint8_t} x,y
+ * @function: void OLED_BenchDecode(const oled_screen_t *const *scrs, uint8_t count)
+ * @description: 界面解码速度测试（调试用）：将各界面解码到临时行缓冲区，不修改显存
+ * @param {const oled_screen_t *const *} scrs 界面列表（如scr_all）
+ * @param {uint8_t} count 界面数
+ * @note  结果记录在oled_stats.decode_bytes/decode_us并输出跟踪事件
  * @return {*}
  */
-void OLED_Set_Pos(uint8_t x, uint8_t y) {
-  OLED_WR_CMD(0xb0 + y);                 // 设置页地址（0~7）
-  OLED_WR_CMD(((x & 0xf0) >> 4) | 0x10); // 设置显示位置—列高地址
-  OLED_WR_CMD(x & 0x0f);                 // 设置显示位置—列低地址
+void OLED_BenchDecode(const oled_screen_t *const *scrs, uint8_t count) {
+  static uint8_t row[OLED_WIDTH];
+  uint32_t bytes = 0;
+  uint32_t t0 = dwt_cycles();
+  uint8_t n, i;
+
+  for (n = 0; n < count; n++) {
+    const uint8_t *src = scrs[n]->data;
+    for (i = scrs[n]->first_page; i <= scrs[n]->last_page; i++) {
+      if (scrs[n]->rle_size != 0) {
+        src += rle_decode(src, row, OLED_WIDTH);
+      } else {
+        memcpy(row, src, OLED_WIDTH);
+        src += OLED_WIDTH;
+      }
+      bytes += OLED_WIDTH;
+    }
+  }
+  oled_stats.decode_bytes = bytes;
+  oled_stats.decode_us = dwt_cycles_to_us(dwt_cycles() - t0);
+  TRACE(TRACE_EV_RLE_BENCH, oled_stats.decode_bytes, oled_stats.decode_us);
 }
 
 /**
- * @function: unsigned int oled_pow(uint8_t m,uint8_t n)
- * @description: m^n函数
- * @param {uint8_t} m,n
- * @return {unsigned int} result
+ * @function: bool OLED_Set_Pos(uint8_t x, uint8_t y)
+ * @description: 坐标设置
+ * @param {uint8_t} x,y
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
  */
-unsigned int oled_pow(uint8_t m, uint8_t n) {
-  unsigned int result = 1;
-  while (n--)
-    result *= m;
-  return result;
+bool OLED_Set_Pos(uint8_t x, uint8_t y) {
+  uint8_t cmds[6];
+  // 水平寻址模式下页地址命令0xB0无效，改用窗口：从(x,y)到屏幕右下角
+  oled_window_cmd(cmds, x, OLED_WIDTH - 1, y, OLED_PAGES - 1);
+  return OLED_WR_CMDS(cmds, sizeof(cmds));
 }
 
 /**
@@ -175,28 +557,25 @@ void OLED_ShowChar(uint8_t x, uint8_t y, uint8_t chr, uint8_t Char_Size,
     y = y + 2;
   }
   if (Char_Size == 16) {
-    OLED_Set_Pos(x, y);
     for (i = 0; i < 8; i++) {
       if (Color_Turn)
-        OLED_WR_DATA(~F8X16[c * 16 + i]);
+        oled_gram_write(y, x + i, ~F8X16[c * 16 + i]);
       else
-        OLED_WR_DATA(F8X16[c * 16 + i]);
+        oled_gram_write(y, x + i, F8X16[c * 16 + i]);
     }
-    OLED_Set_Pos(x, y + 1);
     for (i = 0; i < 8; i++) {
       if (Color_Turn)
-        OLED_WR_DATA(~F8X16[c * 16 + i + 8]);
+        oled_gram_write(y + 1, x + i, ~F8X16[c * 16 + i + 8]);
       else
-        OLED_WR_DATA(F8X16[c * 16 + i + 8]);
+        oled_gram_write(y + 1, x + i, F8X16[c * 16 + i + 8]);
     }
 
   } else {
-    OLED_Set_Pos(x, y);
     for (i = 0; i < 6; i++) {
       if (Color_Turn)
-        OLED_WR_DATA(~F6x8[c][i]);
+        oled_gram_write(y, x + i, ~F6x8[c][i]);
       else
-        OLED_WR_DATA(F6x8[c][i]);
+        oled_gram_write(y, x + i, F6x8[c][i]);
     }
   }
 }
@@ -243,113 +622,307 @@ void OLED_ShowString(uint8_t x, uint8_t y, char *chr, uint8_t Char_Size,
 /**
  * @function: void OLED_ShowNum(uint8_t x,uint8_t y,unsigned int num,uint8_t
  * len,uint8_t size2, Color_Turn)
- * @description: 显示数字
+ * @description: 显示数字（右对齐，高位的0显示为空格，超出len位时只显示低len位）
  * @param {uint8_t} x待显示的数字起始横坐标,x:0~126
  * @param {uint8_t} y待显示的数字起始纵坐标,
  * y:0~7，若选择字体大小为16，则两行数字之间需要间隔2，若选择字体大小为12，间隔1
  * @param {unsigned int} num:输入的数据
- * @param {uint8_t } len:输入的数据位数
+ * @param {uint8_t } len:输入的数据位数（1~10）
  * @param {uint8_t} size2:输入的数据大小，选择 16/12，16为8X16，12为6x8
  * @param {uint8_t} Color_Turn是否反相显示(1反相、0不反相)
  * @return {*}
  */
 void OLED_ShowNum(uint8_t x, uint8_t y, unsigned int num, uint8_t len,
                   uint8_t size2, uint8_t Color_Turn) {
-  uint8_t t, temp;
-  uint8_t enshow = 0;
-  for (t = 0; t < len; t++) {
-    temp = (num / oled_pow(10, len - t - 1)) % 10;
-    if (enshow == 0 && t < (len - 1)) {
-      if (temp == 0) {
-        OLED_ShowChar(x + (size2 / 2) * t, y, ' ', size2, Color_Turn);
-        continue;
-      } else
-        enshow = 1;
-    }
-    OLED_ShowChar(x + (size2 / 2) * t, y, temp + '0', size2, Color_Turn);
-  }
+  char buf[12];
+  char *end;
+  if (len > 10)
+    len = 10;
+  end = fmt_u32(buf, num, len, ' ', 10);
+  OLED_ShowString(x, y, end - len, size2, Color_Turn);
 }
 
 /**
- * @function: void OLED_Showdecimal(uint8_t x,uint8_t y,float num,uint8_t
+ * @function: void OLED_Showdecimal(uint8_t x,uint8_t y,int32_t num,uint8_t
  * z_len,uint8_t f_len,uint8_t size2, uint8_t Color_Turn)
- * @description: 显示正负浮点数
+ * @description: 显示定点小数（不使用浮点）
  * @param {uint8_t} x待显示的数字起始横坐标,x:0~126
  * @param {uint8_t} y待显示的数字起始纵坐标,
  * y:0~7，若选择字体大小为16，则两行数字之间需要间隔2，若选择字体大小为12，间隔1
- * @param {float} num:输入的浮点型数据
- * @param {uint8_t } z_ len:整数部分的位数
- * @param {uint8_t } f_len: 小数部分的位数
+ * @param {int32_t} num:实际值乘以10^f_len，如f_len=2时1234显示为12.34
+ * @param {uint8_t} z_len:整数部分位数（右对齐，不足补空格，负号另占一位）
+ * @param {uint8_t} f_len:小数部分位数（0~9）
  * @param {uint8_t} size2:输入的数据大小，选择 16/12，16为8X16，12为6x8
  * @param {uint8_t} Color_Turn是否反相显示(1反相、0不反相)
  * @return {*}
  */
-void OLED_Showdecimal(uint8_t x, uint8_t y, float num, uint8_t z_len,
+void OLED_Showdecimal(uint8_t x, uint8_t y, int32_t num, uint8_t z_len,
                       uint8_t f_len, uint8_t size2, uint8_t Color_Turn) {
-  uint8_t t, temp, i = 0; // i为负数标志位
-  uint8_t enshow;
-  int z_temp, f_temp;
-  if (num < 0) {
-    z_len += 1;
-    i = 1;
-    num = -num;
-  }
-  z_temp = (int)num;
-  // 整数部分
-  for (t = 0; t < z_len; t++) {
-    temp = (z_temp / oled_pow(10, z_len - t - 1)) % 10;
-    if (enshow == 0 && t < (z_len - 1)) {
-      if (temp == 0) {
-        OLED_ShowChar(x + (size2 / 2) * t, y, ' ', size2, Color_Turn);
-        continue;
-      } else
-        enshow = 1;
-    }
-    OLED_ShowChar(x + (size2 / 2) * t, y, temp + '0', size2, Color_Turn);
-  }
-  // 小数点
-  OLED_ShowChar(x + (size2 / 2) * (z_len), y, '.', size2, Color_Turn);
-
-  f_temp = (int)((num - z_temp) * (oled_pow(10, f_len)));
-  // 小数部分
-  for (t = 0; t < f_len; t++) {
-    temp = (f_temp / oled_pow(10, f_len - t - 1)) % 10;
-    OLED_ShowChar(x + (size2 / 2) * (t + z_len) + 5, y, temp + '0', size2,
-                  Color_Turn);
-  }
-  if (i == 1) // 如果为负，就将最前的一位赋值‘-’
-  {
-    OLED_ShowChar(x, y, '-', size2, Color_Turn);
-    i = 0;
+  char buf[24];
+  uint8_t width = z_len + (f_len > 0 ? f_len + 1 : 0) + (num < 0);
+  fmt_fixed(buf, num, f_len, width, ' ');
+  OLED_ShowString(x, y, buf, size2, Color_Turn);
+}
+
+/**
+ * @function: oled_cjk_find
+ * @description: 在生成的字形表中二分查找码位
+ * @return 字形下标，-1表示字体中没有该字
+ */
+static int oled_cjk_find(uint16_t code) {
+  int lo = 0, hi = FONT_CJK_COUNT - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    if (font_cjk_codes[mid] == code)
+      return mid;
+    if (font_cjk_codes[mid] < code)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
   }
+  return -1;
 }
 
 /**
- * @function: void OLED_ShowCHinese(uint8_t x,uint8_t y,uint8_t no, uint8_t
+ * @function: void OLED_ShowCHinese(uint8_t x,uint8_t y,uint16_t code, uint8_t
  * Color_Turn)
  * @description: 在OLED特定位置开始显示16X16汉字
  * @param {uint8_t} x待显示的汉字起始横坐标x: 0~112，两列汉字之间需要间隔16
  * @param {uint8_t} y待显示的汉字起始纵坐标 y: 0~6 , 两行汉字之间需要间隔2
- * @param {uint8_t} no待显示的汉字编号
+ * @param {uint16_t} code待显示汉字的Unicode码位（须在源码字符串中出现过，才会生成字形）
  * @param {uint8_t} Color_Turn是否反相显示(1反相、0不反相)
  * @return {*}
  */
-void OLED_ShowCHinese(uint8_t x, uint8_t y, uint8_t no, uint8_t Color_Turn) {
+void OLED_ShowCHinese(uint8_t x, uint8_t y, uint16_t code, uint8_t Color_Turn) {
   uint8_t t = 0;
-  OLED_Set_Pos(x, y);
+  int no = oled_cjk_find(code);
+  const uint8_t *glyph = (no >= 0) ? font_cjk_glyphs[no] : NULL;
+  uint8_t mask = Color_Turn ? 0xFF : 0x00;
+
   for (t = 0; t < 16; t++) {
-    if (Color_Turn)
-      OLED_WR_DATA(~Hzk[2 * no][t]); // 显示汉字的上半部分
-    else
-      OLED_WR_DATA(Hzk[2 * no][t]); // 显示汉字的上半部分
+    // 字体中没有的字显示为空白（反相时为实心块）
+    oled_gram_write(y, x + t, (glyph ? glyph[t] : 0x00) ^ mask); // 显示汉字的上半部分
+    oled_gram_write(y + 1, x + t, (glyph ? glyph[16 + t] : 0x00) ^ mask); // 显示汉字的下半部分
   }
+}
 
-  OLED_Set_Pos(x, y + 1);
-  for (t = 0; t < 16; t++) {
-    if (Color_Turn)
-      OLED_WR_DATA(~Hzk[2 * no + 1][t]); // 显示汉字的上半部分
+/**
+ * @function: oled_utf8_next
+ * @description: 取UTF-8字符串中的下一个字符
+ * @param {const uint8_t **} p 读位置，返回时指向下一个字符
+ * @param {uint16_t *} code 码位
+ * @return 显示宽度：ASCII为8，其余为16；0表示非法或四字节序列（已跳过该字节）
+ */
+static uint8_t oled_utf8_next(const uint8_t **p, uint16_t *code) {
+  const uint8_t *s = *p;
+  if (s[0] < 0x80) {
+    *code = s[0];
+    *p = s + 1;
+    return 8;
+  }
+  if ((s[0] & 0xE0) == 0xC0 && s[1] != '\0') {
+    *code = ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+    *p = s + 2;
+    return 16;
+  }
+  if ((s[0] & 0xF0) == 0xE0 && s[1] != '\0' && s[2] != '\0') {
+    *code = ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+    *p = s + 3;
+    return 16;
+  }
+  *p = s + 1;
+  return 0;
+}
+
+/**
+ * @function: void OLED_ShowText(uint8_t x, uint8_t y, const char *str, uint8_t Color_Turn)
+ * @description: 显示UTF-8字符串，ASCII为8X16字符，其余为16X16汉字，超出行尾从下两页继续
+ * @param {uint8_t} x起始横坐标 x: 0~127
+ * @param {uint8_t} y起始纵坐标 y: 0~6
+ * @param {const char *} str UTF-8字符串（汉字字形由构建时扫描源码中的字符串生成）
+ * @param {uint8_t} Color_Turn是否反相显示(1反相、0不反相)
+ * @return {*}
+ */
+void OLED_ShowText(uint8_t x, uint8_t y, const char *str, uint8_t Color_Turn) {
+  const uint8_t *p = (const uint8_t *)str;
+  while (*p != '\0') {
+    uint16_t code;
+    uint8_t width = oled_utf8_next(&p, &code);
+    if (width == 0)
+      continue;
+
+    if (x + width > OLED_WIDTH) {
+      x = 0;
+      y += 2;
+    }
+    if (width == 8)
+      OLED_ShowChar(x, y, (uint8_t)code, 16, Color_Turn);
     else
-      OLED_WR_DATA(Hzk[2 * no + 1][t]); // 显示汉字的上半部分
+      OLED_ShowCHinese(x, y, code, Color_Turn);
+    x += width;
+  }
+}
+
+/**
+ * @function: uint16_t OLED_TextWidth(const char *str)
+ * @description: UTF-8字符串按OLED_ShowText字体单行显示时的宽度（像素）
+ * @param {const char *} str UTF-8字符串
+ * @return {uint16_t} 宽度
+ */
+uint16_t OLED_TextWidth(const char *str) {
+  const uint8_t *p = (const uint8_t *)str;
+  uint16_t width = 0;
+  uint16_t code;
+  while (*p != '\0')
+    width += oled_utf8_next(&p, &code);
+  return width;
+}
+
+/**
+ * @function: uint16_t OLED_TextFit(const char *str, uint16_t max_width)
+ * @description: 单行宽度不超过max_width的最长前缀（按整字符截断）
+ * @param {const char *} str UTF-8字符串
+ * @param {uint16_t} max_width 可用宽度（像素）
+ * @return {uint16_t} 前缀字节数
+ */
+uint16_t OLED_TextFit(const char *str, uint16_t max_width) {
+  const uint8_t *p = (const uint8_t *)str;
+  uint16_t width = 0;
+  uint16_t code;
+  while (*p != '\0') {
+    const uint8_t *next = p;
+    width += oled_utf8_next(&next, &code);
+    if (width > max_width)
+      break;
+    p = next;
+  }
+  return (uint16_t)(p - (const uint8_t *)str);
+}
+
+// 半字节位扩展表：源像素每位复制为相邻两位（bit n -> bit 2n、2n+1），2倍放大时纵向加倍
+static const uint8_t s_spread4[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+};
+
+/**
+ * @function: oled_glyph
+ * @description: 取字符的字形（按页排列，上半页在前），字体中没有的字返回空白字形
+ */
+static const uint8_t *oled_glyph(uint16_t code, uint8_t w) {
+  static const uint8_t blank[32] = {0};
+  if (w == 8) {
+    if (code >= ' ' && code - ' ' < OLED_F8X16_COUNT)
+      return &F8X16[(code - ' ') * 16];
+  } else {
+    int no = oled_cjk_find(code);
+    if (no >= 0)
+      return font_cjk_glyphs[no];
+  }
+  return blank;
+}
+
+/**
+ * @function: oled_scale2x
+ * @description: 按页排列的16像素高字形放大2倍：每列复制一次，每个源字节查表拆成上下两页
+ * @param {const uint8_t *} src 源字形，2行、每行w字节
+ * @param {uint8_t} w 源宽度（像素）
+ * @param {uint8_t *} dst 放大结果，4行、每行2w字节
+ */
+static void oled_scale2x(const uint8_t *src, uint8_t w, uint8_t *dst) {
+  uint8_t r, c;
+  for (r = 0; r < 2; r++) {
+    uint8_t *lo = &dst[(r * 2) * w * 2];
+    uint8_t *hi = lo + w * 2;
+    for (c = 0; c < w; c++) {
+      uint8_t b = src[r * w + c];
+      lo[c * 2] = lo[c * 2 + 1] = s_spread4[b & 0x0F];
+      hi[c * 2] = hi[c * 2 + 1] = s_spread4[b >> 4];
+    }
+  }
+}
+
+/**
+ * @function: oled_draw_text
+ * @description: OLED_DrawText与OLED_DrawText2X的共同实现，scale为1或2
+ */
+static uint16_t oled_draw_text(int16_t x, int16_t y, const char *str,
+                               uint8_t align, uint8_t mode, uint8_t scale) {
+  static uint8_t big[4 * 32]; // 放大后的字形：4行，最宽32列
+  const uint8_t *p = (const uint8_t *)str;
+  uint16_t width = OLED_TextWidth(str) * scale;
+  uint16_t code;
+
+  if (align == OLED_ALIGN_CENTER)
+    x -= width / 2;
+  else if (align == OLED_ALIGN_RIGHT)
+    x -= width;
+
+  while (*p != '\0' && x < OLED_WIDTH) {
+    uint8_t w = oled_utf8_next(&p, &code);
+    if (w == 0)
+      continue;
+    if (x + w * scale > 0) {
+      const uint8_t *glyph = oled_glyph(code, w);
+      if (scale == 2) {
+        oled_scale2x(glyph, w, big);
+        OLED_Blit(x, y, w * 2, 32, big, mode);
+      } else {
+        OLED_Blit(x, y, w, 16, glyph, mode); // 字形与显存同为按页排列：上半页在前
+      }
+    }
+    x += w * scale;
+  }
+  return width;
+}
+
+/**
+ * @function: uint16_t OLED_DrawText(int16_t x, int16_t y, const char *str, uint8_t align, uint8_t mode)
+ * @description: 在任意像素位置单行显示UTF-8字符串：ASCII为8X16字符，其余为16X16汉字，
+ *               超出屏幕的部分裁掉，不换行
+ * @param {int16_t} x 锚点横坐标，文字相对锚点的位置由align决定
+ * @param {int16_t} y 文字顶部的像素行，可不按页对齐
+ * @param {const char *} str UTF-8字符串（汉字字形由构建时扫描源码中的字符串生成）
+ * @param {uint8_t} align OLED_ALIGN_LEFT/OLED_ALIGN_CENTER/OLED_ALIGN_RIGHT
+ * @param {uint8_t} mode OLED_COPY背景清零，OLED_SET/OLED_CLEAR/OLED_XOR只作用于笔画（见OLED_Blit）
+ * @note  字形按码位在有序表中二分查找，字体中没有的字显示为空白
+ * @return {uint16_t} 文字宽度（像素）
+ */
+uint16_t OLED_DrawText(int16_t x, int16_t y, const char *str, uint8_t align,
+                       uint8_t mode) {
+  return oled_draw_text(x, y, str, align, mode, 1);
+}
+
+/**
+ * @function: uint16_t OLED_DrawText2X(int16_t x, int16_t y, const char *str, uint8_t align, uint8_t mode)
+ * @description: 同OLED_DrawText，字形放大2倍显示：ASCII为16X32，汉字为32X32（大字时钟、序号）
+ * @note  放大在绘制时逐字查表完成，不另存大字体；每个字先放大到128字节的缓冲区再整块写入显存，
+ *        只改一位数字时只有这16列被标记为待刷新
+ * @return {uint16_t} 文字宽度（像素）
+ */
+uint16_t OLED_DrawText2X(int16_t x, int16_t y, const char *str, uint8_t align,
+                         uint8_t mode) {
+  return oled_draw_text(x, y, str, align, mode, 2);
+}
+
+/**
+ * @function: void OLED_BenchText(const char *const *strs, uint8_t count)
+ * @description: 逐条测量OLED_DrawText的绘制耗时（调试用），每条输出一个跟踪事件
+ * @param {const char *const *} strs 字符串列表
+ * @param {uint8_t} count 字符串数
+ * @note  在第2~3页以OLED_XOR画两遍，显存内容不变；最大耗时记录在oled_stats.text_cycles_max
+ * @return {*}
+ */
+void OLED_BenchText(const char *const *strs, uint8_t count) {
+  uint8_t n;
+  for (n = 0; n < count; n++) {
+    uint32_t t0 = dwt_cycles();
+    OLED_DrawText(0, 16, strs[n], OLED_ALIGN_LEFT, OLED_XOR);
+    uint32_t cycles = dwt_cycles() - t0;
+    OLED_DrawText(0, 16, strs[n], OLED_ALIGN_LEFT, OLED_XOR);
+    if (cycles > oled_stats.text_cycles_max)
+      oled_stats.text_cycles_max = cycles;
+    TRACE(TRACE_EV_TEXT_BENCH, OLED_TextWidth(strs[n]), cycles);
   }
 }
 
@@ -375,98 +948,271 @@ void OLED_DrawBMP(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t *BMP,
   else
     y = y1 / 8 + 1;
   for (y = y0; y < y1; y++) {
-    OLED_Set_Pos(x0, y);
     for (x = x0; x < x1; x++) {
       if (Color_Turn)
-        OLED_WR_DATA(~BMP[j++]); // 显示反相图片
+        oled_gram_write(y, x, ~BMP[j++]); // 显示反相图片
       else
-        OLED_WR_DATA(BMP[j++]); // 显示图片
+        oled_gram_write(y, x, BMP[j++]); // 显示图片
     }
   }
 }
 
 /**
- * @function: void OLED_HorizontalShift(uint8_t direction)
- * @description: 屏幕内容水平全屏滚动播放
+ * @function: oled_gram_op
+ * @description: 按绘图方式修改显存一个字节中mask选中的像素，bits为源像素
+ */
+static void oled_gram_op(uint8_t page, uint8_t x, uint8_t mask, uint8_t bits,
+                         uint8_t mode) {
+  uint8_t old = OLED_GRAM[page][x];
+  uint8_t v;
+  bits &= mask;
+  switch (mode) {
+  case OLED_CLEAR:
+    v = old & ~bits;
+    break;
+  case OLED_XOR:
+    v = old ^ bits;
+    break;
+  case OLED_COPY:
+    v = (old & ~mask) | bits;
+    break;
+  default:
+    v = old | bits;
+    break;
+  }
+  oled_gram_write(page, x, v);
+}
+
+/**
+ * @function: void OLED_FillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t mode)
+ * @description: 填充矩形区域（含边界），每页一个字节掩码处理8行像素
+ * @param {uint8_t} x0,x1 列范围 0~127，超出屏幕部分裁掉
+ * @param {uint8_t} y0,y1 像素行范围 0~63，超出屏幕部分裁掉
+ * @param {uint8_t} mode OLED_CLEAR清除、OLED_SET点亮、OLED_XOR取反（反显区域）
+ * @return {*}
+ */
+void OLED_FillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1,
+                   uint8_t mode) {
+  uint8_t page, x;
+
+  if (x1 >= OLED_WIDTH)
+    x1 = OLED_WIDTH - 1;
+  if (y1 >= OLED_PAGES * 8)
+    y1 = OLED_PAGES * 8 - 1;
+  if (x0 > x1 || y0 > y1)
+    return;
+
+  for (page = y0 >> 3; page <= (y1 >> 3); page++) {
+    uint8_t mask = 0xFF;
+    if (page == (y0 >> 3))
+      mask &= (uint8_t)(0xFF << (y0 & 7));
+    if (page == (y1 >> 3))
+      mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+    for (x = x0; x <= x1; x++)
+      oled_gram_op(page, x, mask, 0xFF, mode);
+  }
+}
+
+/**
+ * @function: void OLED_HLine(uint8_t x0, uint8_t x1, uint8_t y, uint8_t mode)
+ * @description: 画水平线
+ * @return {*}
+ */
+void OLED_HLine(uint8_t x0, uint8_t x1, uint8_t y, uint8_t mode) {
+  OLED_FillRect(x0, y, x1, y, mode);
+}
+
+/**
+ * @function: void OLED_VLine(uint8_t x, uint8_t y0, uint8_t y1, uint8_t mode)
+ * @description: 画垂直线
+ * @return {*}
+ */
+void OLED_VLine(uint8_t x, uint8_t y0, uint8_t y1, uint8_t mode) {
+  OLED_FillRect(x, y0, x, y1, mode);
+}
+
+/**
+ * @function: void OLED_Rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t mode)
+ * @description: 画矩形边框（四角只画一次，OLED_XOR时同样正确）
+ * @return {*}
+ */
+void OLED_Rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t mode) {
+  OLED_HLine(x0, x1, y0, mode);
+  if (y1 > y0)
+    OLED_HLine(x0, x1, y1, mode);
+  if (y1 > y0 + 1) {
+    OLED_VLine(x0, y0 + 1, y1 - 1, mode);
+    if (x1 > x0)
+      OLED_VLine(x1, y0 + 1, y1 - 1, mode);
+  }
+}
+
+/**
+ * @function: void OLED_Blit(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bmp, uint8_t mode)
+ * @description: 在任意像素位置绘制单色位图，超出屏幕的部分裁掉
+ * @param {int16_t} x,y 左上角坐标，可为负或超出屏幕
+ * @param {uint8_t} w,h 位图宽高（像素）
+ * @param {const uint8_t *} bmp 位图，与显存相同的按页排列：(h+7)/8行，每行w字节，低位在上
+ * @param {uint8_t} mode OLED_COPY覆盖，OLED_SET/OLED_CLEAR/OLED_XOR只作用于位图中为1的像素
+ * @note  y不是8的倍数时每个源字节拆到上下两页，仍按字节处理
+ * @return {*}
+ */
+void OLED_Blit(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bmp,
+               uint8_t mode) {
+  uint8_t rows = (h + 7) / 8;
+  uint8_t r, c;
+
+  for (r = 0; r < rows; r++) {
+    int16_t top = y + r * 8;            // 本行源像素在屏幕上的首行
+    int16_t page = (top + 64) / 8 - 8;  // 向下取整（top可为负）
+    uint8_t shift = (uint8_t)(top - page * 8);
+    uint8_t valid = (r == rows - 1 && (h & 7)) ? (uint8_t)(0xFF >> (8 - (h & 7))) : 0xFF;
+    const uint8_t *src = &bmp[r * w];
+
+    if (page + 1 < 0 || page >= OLED_PAGES)
+      continue;
+    for (c = 0; c < w; c++) {
+      int16_t col = x + c;
+      if (col < 0 || col >= OLED_WIDTH)
+        continue;
+      if (page >= 0)
+        oled_gram_op(page, col, (uint8_t)(valid << shift), (uint8_t)(src[c] << shift), mode);
+      if (shift != 0 && page + 1 < OLED_PAGES)
+        oled_gram_op(page + 1, col, (uint8_t)(valid >> (8 - shift)),
+                     (uint8_t)(src[c] >> (8 - shift)), mode);
+    }
+  }
+}
+
+/**
+ * @function: bool OLED_ScrollStart(uint8_t direction, uint8_t start, uint8_t end, uint8_t interval)
+ * @description: 开启页范围内的硬件水平滚动，之后由面板自行移动画面，不占用MCU与I2C
  * @param {uint8_t} direction			LEFT	   0x27     	RIGHT
  * 0x26
- * @return {*}
+ * @param {uint8_t} start 开始页地址  0x00~0x07
+ * @param {uint8_t} end  结束页地址  start~0x07
+ * @param {uint8_t} interval 每步间隔帧数  0x00-5帧， 0x01-64帧， 0x02-128帧，
+ * 0x03-256帧， 0x04-3帧， 0x05-4帧， 0x06-25帧， 0x07-2帧
+ * @note  滚动期间禁止写GDDRAM：调用前显存须已全部刷新（OLED_Busy()为false），
+ *        之后有绘制时OLED_Refresh自动停止滚动并重发这些页
+ * @return {bool} true=已排队；false=显示队列已满，未开始滚动，调用者稍后重试
  */
-void OLED_HorizontalShift(uint8_t direction)
+bool OLED_ScrollStart(uint8_t direction, uint8_t start, uint8_t end,
+                      uint8_t interval) {
+  uint8_t cmds[] = {
+      0x2e,      // 停止滚动
+      direction, // 设置滚动方向
+      0x00,      // 虚拟字节设置，默认为0x00
+      start,     // 设置开始页地址
+      interval,  // 设置每个滚动步骤之间的时间间隔的帧频
+      end,       // 设置结束页地址
+      0x00,      // 虚拟字节设置，默认为0x00
+      0xff,      // 虚拟字节设置，默认为0xff
+      0x2f,      // 开启滚动
+  };
+  if (!OLED_WR_CMDS(cmds, sizeof(cmds)))
+    return false;
+  s_scroll_first = start;
+  s_scroll_last = end;
+  return true;
+}
 
-{
-  OLED_WR_CMD(0x2e);      // 停止滚动
-  OLED_WR_CMD(direction); // 设置滚动方向
-  OLED_WR_CMD(0x00);      // 虚拟字节设置，默认为0x00
-  OLED_WR_CMD(0x00);      // 设置开始页地址
-  OLED_WR_CMD(0x07); // 设置每个滚动步骤之间的时间间隔的帧频
-  //  0x00-5帧， 0x01-64帧， 0x02-128帧， 0x03-256帧， 0x04-3帧， 0x05-4帧，
-  //  0x06-25帧， 0x07-2帧，
-  OLED_WR_CMD(0x07); // 设置结束页地址
-  OLED_WR_CMD(0x00); // 虚拟字节设置，默认为0x00
-  OLED_WR_CMD(0xff); // 虚拟字节设置，默认为0xff
-  OLED_WR_CMD(0x2f); // 开启滚动-0x2f，禁用滚动-0x2e，禁用需要重写数据
+/**
+ * @function: bool OLED_ScrollStop(void)
+ * @description: 停止硬件滚动，被滚动的页标记为待刷新，下次刷新时恢复原内容
+ * @return {bool} true=未在滚动或已排队；false=显示队列已满，仍在滚动，
+ *         OLED_Refresh在有改动时会再次停止
+ */
+bool OLED_ScrollStop(void) {
+  static const uint8_t cmds[] = {
+      0x2e, // 停止滚动，GDDRAM保持滚动到的位置，需要重写数据
+      0x40, // 起始行复位（垂直滚动会改变起始行）
+  };
+  uint8_t i;
+  if (s_scroll_first >= OLED_PAGES)
+    return true;
+  if (!OLED_WR_CMDS(cmds, sizeof(cmds)))
+    return false;
+  for (i = s_scroll_first; i <= s_scroll_last && i < OLED_PAGES; i++)
+    oled_mark_dirty(i, 0, OLED_WIDTH - 1);
+  s_scroll_first = OLED_PAGES;
+  return true;
+}
+
+/**
+ * @function: bool OLED_Scrolling(void)
+ * @description: 硬件滚动是否在进行（OLED_Refresh有改动时会自动停止滚动）
+ * @return {bool}
+ */
+bool OLED_Scrolling(void) { return s_scroll_first < OLED_PAGES; }
+
+/**
+ * @function: bool OLED_HorizontalShift(uint8_t direction)
+ * @description: 屏幕内容水平全屏滚动播放
+ * @param {uint8_t} direction			LEFT	   0x27     	RIGHT
+ * 0x26
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
+ */
+bool OLED_HorizontalShift(uint8_t direction) {
+  return OLED_ScrollStart(direction, 0x00, 0x07, 0x07); // 全部页，滚动速度2帧
 }
 
 /**
- * @function: void OLED_Some_HorizontalShift(uint8_t direction,uint8_t
+ * @function: bool OLED_Some_HorizontalShift(uint8_t direction,uint8_t
  * start,uint8_t end)
  * @description: 屏幕部分内容水平滚动播放
  * @param {uint8_t} direction			LEFT	   0x27     	RIGHT
  * 0x26
  * @param {uint8_t} start 开始页地址  0x00~0x07
  * @param {uint8_t} end  结束页地址  0x01~0x07
- * @return {*}
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
  */
-void OLED_Some_HorizontalShift(uint8_t direction, uint8_t start, uint8_t end) {
-  OLED_WR_CMD(0x2e);      // 停止滚动
-  OLED_WR_CMD(direction); // 设置滚动方向
-  OLED_WR_CMD(0x00);      // 虚拟字节设置，默认为0x00
-  OLED_WR_CMD(start);     // 设置开始页地址
-  OLED_WR_CMD(0x07); // 设置每个滚动步骤之间的时间间隔的帧频,0x07即滚动速度2帧
-  OLED_WR_CMD(end);  // 设置结束页地址
-  OLED_WR_CMD(0x00); // 虚拟字节设置，默认为0x00
-  OLED_WR_CMD(0xff); // 虚拟字节设置，默认为0xff
-  OLED_WR_CMD(0x2f); // 开启滚动-0x2f，禁用滚动-0x2e，禁用需要重写数据
+bool OLED_Some_HorizontalShift(uint8_t direction, uint8_t start, uint8_t end) {
+  return OLED_ScrollStart(direction, start, end, 0x07); // 滚动速度2帧
 }
 
 /**
- * @function: void OLED_VerticalAndHorizontalShift(uint8_t direction)
+ * @function: bool OLED_VerticalAndHorizontalShift(uint8_t direction)
  * @description: 屏幕内容垂直水平全屏滚动播放
  * @param {uint8_t} direction				右上滚动	 0x29
  *                                                            左上滚动   0x2A
- * @return {*}
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
  */
-void OLED_VerticalAndHorizontalShift(uint8_t direction) {
-  OLED_WR_CMD(0x2e);      // 停止滚动
-  OLED_WR_CMD(direction); // 设置滚动方向
-  OLED_WR_CMD(0x01);      // 虚拟字节设置
-  OLED_WR_CMD(0x00);      // 设置开始页地址
-  OLED_WR_CMD(0x07); // 设置每个滚动步骤之间的时间间隔的帧频，即滚动速度
-  OLED_WR_CMD(0x07); // 设置结束页地址
-  OLED_WR_CMD(0x01); // 垂直滚动偏移量
-  OLED_WR_CMD(0x00); // 虚拟字节设置，默认为0x00
-  OLED_WR_CMD(0xff); // 虚拟字节设置，默认为0xff
-  OLED_WR_CMD(0x2f); // 开启滚动-0x2f，禁用滚动-0x2e，禁用需要重写数据
+bool OLED_VerticalAndHorizontalShift(uint8_t direction) {
+  uint8_t cmds[] = {
+      0x2e,      // 停止滚动
+      direction, // 设置滚动方向
+      0x01,      // 虚拟字节设置
+      0x00,      // 设置开始页地址
+      0x07, // 设置每个滚动步骤之间的时间间隔的帧频，即滚动速度
+      0x07, // 设置结束页地址
+      0x01, // 垂直滚动偏移量（该命令只有5个参数，没有水平滚动的两个虚拟字节）
+      0x2f, // 开启滚动-0x2f，禁用滚动-0x2e，禁用需要重写数据
+  };
+  if (!OLED_WR_CMDS(cmds, sizeof(cmds)))
+    return false;
+  s_scroll_first = 0;
+  s_scroll_last = OLED_PAGES - 1;
+  return true;
 }
 
 /**
- * @function: void OLED_DisplayMode(uint8_t mode)
+ * @function: bool OLED_DisplayMode(uint8_t mode)
  * @description: 屏幕内容取反显示
- * @param {uint8_t} direction			ON	0xA7  ，
+ * @param {uint8_t} mode			ON	0xA7  ，
  *                                                          OFF	0xA6
  * 默认此模式，设置像素点亮
- * @return {*}
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
  */
-void OLED_DisplayMode(uint8_t mode) { OLED_WR_CMD(mode); }
+bool OLED_DisplayMode(uint8_t mode) { return OLED_WR_CMDS(&mode, 1); }
 
 /**
- * @function: void OLED_IntensityControl(uint8_t intensity)
+ * @function: bool OLED_IntensityControl(uint8_t intensity)
  * @description: 屏幕亮度调节
  * @param  {uint8_t} intensity	0x00~0xFF,RESET=0x7F
- * @return {*}
+ * @return {bool} true=已排队；false=显示队列已满，未发送，调用者稍后重试
  */
-void OLED_IntensityControl(uint8_t intensity) {
-  OLED_WR_CMD(0x81);
-  OLED_WR_CMD(intensity);
+bool OLED_IntensityControl(uint8_t intensity) {
+  uint8_t cmds[] = {0x81, intensity};
+  return OLED_WR_CMDS(cmds, sizeof(cmds));
 }
@@ -0,0 +1,272 @@
+#include "oled_i2c.h"
+#include "dwt.h"
+#include "i2c.h"
+#include "trace.h"
+
+volatile oled_i2c_stats_t oled_i2c_stats = {0};
+
+// DMA传输完成回调（I2C中断上下文）
+static oled_i2c_cb_t s_cb = NULL;
+static void *s_cb_arg = NULL;
+// DMA传输进行中
+static volatile bool s_busy = false;
+// 当前DMA传输的开始时刻（HAL_GetTick）
+static volatile uint32_t s_start_tick = 0;
+// 故障后暂停发送：开始时刻与时长（0表示未暂停），下一次暂停的时长
+static volatile uint32_t s_backoff_start = 0;
+static volatile uint32_t s_backoff_ms = 0;
+static volatile uint32_t s_backoff_next = OLED_I2C_BACKOFF_MS;
+
+/**
+ * @brief 忙等待us微秒（DWT计数，可在中断中使用）
+ */
+static void oled_i2c_delay_us(uint32_t us) {
+  uint32_t start = dwt_cycles();
+  while (dwt_cycles() - start < us * DWT_CYCLES_PER_US) {
+  }
+}
+
+/**
+ * @brief 等待总线空闲（上次传输的STOP发出后BUSY需几微秒才清零）
+ * @return bool true=空闲；false=超过OLED_I2C_IDLE_WAIT_US仍忙
+ */
+static bool oled_i2c_bus_idle(void) {
+  uint32_t start = dwt_cycles();
+  while (__HAL_I2C_GET_FLAG(&hi2c1, I2C_FLAG_BUSY) != RESET) {
+    if (dwt_cycles() - start > OLED_I2C_IDLE_WAIT_US * DWT_CYCLES_PER_US) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 总线恢复：手动输出最多9个SCL时钟让从机释放SDA，发出STOP，再软件复位I2C外设
+ * @note  即STM32F1勘误中BUSY位锁死的处理流程；耗时有上限（约120us），可在中断中调用
+ */
+static void oled_i2c_recover(void) {
+  GPIO_InitTypeDef gpio = {0};
+  uint8_t i;
+
+  oled_i2c_stats.recover++;
+  if (hi2c1.hdmatx != NULL) {
+    HAL_DMA_Abort(hi2c1.hdmatx);
+  }
+  __HAL_I2C_DISABLE(&hi2c1);
+
+  // 两线切换为开漏输出并释放
+  HAL_GPIO_WritePin(OLED_I2C_GPIO_Port, OLED_I2C_SCL_Pin | OLED_I2C_SDA_Pin, GPIO_PIN_SET);
+  gpio.Pin = OLED_I2C_SCL_Pin | OLED_I2C_SDA_Pin;
+  gpio.Mode = GPIO_MODE_OUTPUT_OD;
+  gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_Init(OLED_I2C_GPIO_Port, &gpio);
+  oled_i2c_delay_us(OLED_I2C_RECOVER_HALF_US);
+
+  // 从机正在输出数据位时会拉住SDA，补足时钟直到它放开
+  for (i = 0; i < 9; i++) {
+    if (HAL_GPIO_ReadPin(OLED_I2C_GPIO_Port, OLED_I2C_SDA_Pin) == GPIO_PIN_SET) {
+      break;
+    }
+    HAL_GPIO_WritePin(OLED_I2C_GPIO_Port, OLED_I2C_SCL_Pin, GPIO_PIN_RESET);
+    oled_i2c_delay_us(OLED_I2C_RECOVER_HALF_US);
+    HAL_GPIO_WritePin(OLED_I2C_GPIO_Port, OLED_I2C_SCL_Pin, GPIO_PIN_SET);
+    oled_i2c_delay_us(OLED_I2C_RECOVER_HALF_US);
+  }
+
+  // STOP：SCL高电平期间SDA由低变高，从机回到空闲
+  HAL_GPIO_WritePin(OLED_I2C_GPIO_Port, OLED_I2C_SCL_Pin, GPIO_PIN_RESET);
+  oled_i2c_delay_us(OLED_I2C_RECOVER_HALF_US);
+  HAL_GPIO_WritePin(OLED_I2C_GPIO_Port, OLED_I2C_SDA_Pin, GPIO_PIN_RESET);
+  oled_i2c_delay_us(OLED_I2C_RECOVER_HALF_US);
+  HAL_GPIO_WritePin(OLED_I2C_GPIO_Port, OLED_I2C_SCL_Pin, GPIO_PIN_SET);
+  oled_i2c_delay_us(OLED_I2C_RECOVER_HALF_US);
+  HAL_GPIO_WritePin(OLED_I2C_GPIO_Port, OLED_I2C_SDA_Pin, GPIO_PIN_SET);
+  oled_i2c_delay_us(OLED_I2C_RECOVER_HALF_US);
+
+  gpio.Mode = GPIO_MODE_AF_OD;
+  HAL_GPIO_Init(OLED_I2C_GPIO_Port, &gpio);
+
+  // 软件复位清除BUSY等状态位，再按原配置初始化（状态不为RESET时HAL_I2C_Init不重复MspInit）
+  SET_BIT(hi2c1.Instance->CR1, I2C_CR1_SWRST);
+  CLEAR_BIT(hi2c1.Instance->CR1, I2C_CR1_SWRST);
+  hi2c1.Lock = HAL_UNLOCKED;
+  hi2c1.State = HAL_I2C_STATE_READY;
+  HAL_I2C_Init(&hi2c1);
+}
+
+/**
+ * @brief 开始一段暂停发送（连续故障时时长逐次加倍）
+ */
+static void oled_i2c_backoff_start(void) {
+  s_backoff_start = HAL_GetTick();
+  s_backoff_ms = s_backoff_next;
+  if (s_backoff_next < OLED_I2C_BACKOFF_MAX_MS) {
+    s_backoff_next *= 2U;
+  }
+}
+
+/**
+ * @brief 记录一次故障：需要时恢复总线，并暂停发送
+ * @param error HAL_I2C_ERROR_*按位组合，或OLED_I2C_FAULT_BUSY
+ * @note  无应答时HAL已发出STOP，总线正常，只暂停发送；其余故障先恢复总线
+ */
+static void oled_i2c_fault(uint32_t error) {
+  if (error & HAL_I2C_ERROR_AF) {
+    oled_i2c_stats.nack++;
+  }
+  if (error & HAL_I2C_ERROR_ARLO) {
+    oled_i2c_stats.arlo++;
+  }
+  if (error & HAL_I2C_ERROR_BERR) {
+    oled_i2c_stats.bus_error++;
+  }
+  if (error & OLED_I2C_FAULT_BUSY) {
+    oled_i2c_stats.bus_busy++;
+  }
+  if ((error & ~(HAL_I2C_ERROR_AF | HAL_I2C_ERROR_ARLO | HAL_I2C_ERROR_BERR |
+                 OLED_I2C_FAULT_BUSY)) != 0 ||
+      error == HAL_I2C_ERROR_NONE) {
+    oled_i2c_stats.timeout++;
+  }
+  if (error != HAL_I2C_ERROR_AF) {
+    oled_i2c_recover();
+  }
+  oled_i2c_backoff_start();
+  TRACE(TRACE_EV_I2C_FAULT, error, oled_i2c_stats.recover);
+}
+
+/**
+ * @brief 是否处于故障后的暂停发送期间（此时传输直接失败，不占用总线）
+ */
+bool oled_i2c_backoff(void) {
+  if (s_backoff_ms != 0 && HAL_GetTick() - s_backoff_start >= s_backoff_ms) {
+    s_backoff_ms = 0;
+  }
+  return s_backoff_ms != 0;
+}
+
+/**
+ * @brief 启动传输前的检查：暂停期间直接放弃；总线一直忙时先恢复
+ * @return bool true=可以开始传输
+ * @note  等待时间有上限（DWT计数），可在中断中调用
+ */
+static bool oled_i2c_ready(void) {
+  if (oled_i2c_backoff()) {
+    oled_i2c_stats.skipped++;
+    return false;
+  }
+  if (hi2c1.State != HAL_I2C_STATE_READY || !oled_i2c_bus_idle()) {
+    oled_i2c_fault(OLED_I2C_FAULT_BUSY);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief 等待上一次DMA传输结束（主循环调用）
+ * @return bool true=总线空闲；false=超时（由oled_i2c_poll中止传输）
+ */
+bool oled_i2c_wait_idle(void) {
+  uint32_t start = HAL_GetTick();
+  while (s_busy) {
+    if (HAL_GetTick() - start > OLED_I2C_TIMEOUT_MS) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 阻塞写：控制字节后连续发送len字节，整段只占一次I2C传输
+ * @param ctrl OLED_CTRL_CMD（命令列表）或OLED_CTRL_DATA（显存数据）
+ * @param buf  数据
+ * @param len  字节数
+ * @return bool true=发送成功；false=出错或暂停发送中（最长阻塞OLED_I2C_TIMEOUT_MS）
+ */
+bool oled_i2c_write(uint8_t ctrl, const uint8_t *buf, uint16_t len) {
+  if (!oled_i2c_wait_idle() || !oled_i2c_ready()) {
+    return false;
+  }
+  if (HAL_I2C_Mem_Write(&hi2c1, OLED_I2C_ADDR, ctrl, I2C_MEMADD_SIZE_8BIT,
+                        (uint8_t *)buf, len, OLED_I2C_TIMEOUT_MS) != HAL_OK) {
+    oled_i2c_fault(hi2c1.ErrorCode);
+    return false;
+  }
+  s_backoff_next = OLED_I2C_BACKOFF_MS;
+  return true;
+}
+
+/**
+ * @brief 非阻塞写：由DMA发送，完成后在中断中调用cb
+ * @param buf  控制字节（OLED_CTRL_CMD或OLED_CTRL_DATA）+ 数据，传输完成前必须保持有效
+ * @param len  字节数（含控制字节）
+ * @param cb   完成回调（可为NULL，中断上下文），可在回调中启动下一次传输
+ * @param arg  回调参数
+ * @return bool true=传输已启动；false=总线忙、故障暂停中或启动失败（不调用cb）
+ * @note  起始位与地址由I2C事件中断（SB/ADDR）处理，启动时不等待总线应答，
+ *        可在中断中调用；地址无应答在错误中断中按失败结束
+ */
+bool oled_i2c_write_dma(const uint8_t *buf, uint16_t len, oled_i2c_cb_t cb,
+                        void *arg) {
+  if (s_busy || !oled_i2c_ready()) {
+    return false;
+  }
+  s_cb = cb;
+  s_cb_arg = arg;
+  s_start_tick = HAL_GetTick();
+  s_busy = true;
+  if (HAL_I2C_Master_Seq_Transmit_DMA(&hi2c1, OLED_I2C_ADDR, (uint8_t *)buf, len,
+                                      I2C_FIRST_AND_LAST_FRAME) != HAL_OK) {
+    s_busy = false;
+    oled_i2c_fault(hi2c1.ErrorCode); // DMA启动失败等
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief DMA传输是否进行中
+ */
+bool oled_i2c_busy(void) { return s_busy; }
+
+/**
+ * @brief 结束当前传输并调用完成回调
+ */
+static void oled_i2c_complete(bool ok) {
+  oled_i2c_cb_t cb = s_cb;
+  s_cb = NULL;
+  s_busy = false;
+  if (cb != NULL) {
+    cb(ok, s_cb_arg);
+  }
+}
+
+/**
+ * @brief DMA传输超时检查（主循环调用）：完成中断迟迟不来时中止传输、恢复总线，按失败结束
+ */
+void oled_i2c_poll(void) {
+  if (!s_busy || HAL_GetTick() - s_start_tick <= OLED_I2C_TIMEOUT_MS) {
+    return;
+  }
+  __disable_irq();
+  if (s_busy) { // 关中断后再确认，完成中断可能刚刚处理完
+    oled_i2c_fault(HAL_I2C_ERROR_TIMEOUT);
+    // 完成回调会立即启动队列中的下一条：暂停发送期间启动直接失败，剩余操作逐条丢弃，很快返回
+    oled_i2c_complete(false);
+  }
+  __enable_irq();
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c->Instance == I2C1) {
+    s_backoff_next = OLED_I2C_BACKOFF_MS;
+    oled_i2c_complete(true);
+  }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c->Instance == I2C1) {
+    oled_i2c_fault(hi2c->ErrorCode);
+    oled_i2c_complete(false); // 出错也要结束传输链，避免显示流程卡死
+  }
+}
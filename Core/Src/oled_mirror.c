@@ -0,0 +1,99 @@
+#include "oled_mirror.h"
+#include "oled.h"
+#include "usart.h"
+
+volatile oled_mirror_stats_t oled_mirror_stats = {0};
+
+#if OLED_MIRROR_ENABLE
+
+// 每页已写入面板、尚未发给主机的列范围[lo, hi]，lo > hi表示无改动（仅主循环访问）
+static uint8_t s_lo[OLED_PAGES];
+static uint8_t s_hi[OLED_PAGES];
+static uint8_t s_pending = 0; // 有改动的页（位图）
+static uint8_t s_next = 0;    // 下次优先发送的页（各页轮流，避免某页持续改动时其他页等待）
+static uint8_t s_seq = 0;     // 帧序号，主机端据此发现丢帧
+// DMA发送缓冲区（发送期间可继续标记改动）
+static uint8_t s_tx[6 + OLED_WIDTH + 1];
+
+/**
+ * @brief 记录一个写入面板的窗口（OLED_Refresh提交窗口时调用，只合并列范围）
+ * @param p0,p1 起止页
+ * @param x0,x1 起止列
+ * @note  同一区域多次改动在发送前合并，只发最新内容
+ */
+void oled_mirror_mark(uint8_t p0, uint8_t p1, uint8_t x0, uint8_t x1) {
+  uint8_t i;
+  for (i = p0; i <= p1; i++) {
+    if (!(s_pending & (1U << i))) {
+      s_lo[i] = x0;
+      s_hi[i] = x1;
+      s_pending |= (uint8_t)(1U << i);
+      continue;
+    }
+    if (s_lo[i] > x0)
+      s_lo[i] = x0;
+    if (s_hi[i] < x1)
+      s_hi[i] = x1;
+  }
+}
+
+/**
+ * @brief 将一页的改动列从显存打包经USART3 DMA发出（主循环调用，在OLED_Refresh之后）
+ * @note  串口忙（跟踪记录或上一帧发送中）时直接返回；每次只发一页，帧格式见OLED_MIRROR_SYNC0
+ */
+void oled_mirror_drain(void) {
+  uint8_t page, len, bcc = 0;
+  uint16_t i, size;
+
+  if (s_pending == 0 || huart3.gState != HAL_UART_STATE_READY) {
+    return;
+  }
+  while (!(s_pending & (1U << s_next))) {
+    s_next = (s_next + 1U) % OLED_PAGES;
+  }
+  page = s_next;
+  s_next = (s_next + 1U) % OLED_PAGES;
+  s_pending &= (uint8_t)~(1U << page);
+
+  len = s_hi[page] - s_lo[page] + 1U;
+  s_tx[0] = OLED_MIRROR_SYNC0;
+  s_tx[1] = OLED_MIRROR_SYNC1;
+  s_tx[2] = s_seq++;
+  s_tx[3] = page;
+  s_tx[4] = s_lo[page];
+  s_tx[5] = len;
+  OLED_ReadGram(page, s_lo[page], len, &s_tx[6]);
+  size = 6U + len;
+
+  // 与跟踪帧相同的异或校验，从序号开始计算
+  for (i = 2; i < size; i++) {
+    bcc ^= s_tx[i];
+  }
+  s_tx[size++] = bcc;
+
+  oled_mirror_stats.packets++;
+  oled_mirror_stats.bytes += len;
+  HAL_UART_Transmit_DMA(&huart3, s_tx, size);
+}
+
+/**
+ * @brief 是否有改动尚未发出（有则不进入Stop，避免DMA发送被中断）
+ */
+bool oled_mirror_busy(void) {
+  return s_pending != 0 || huart3.gState != HAL_UART_STATE_READY;
+}
+
+#else
+
+void oled_mirror_mark(uint8_t p0, uint8_t p1, uint8_t x0, uint8_t x1) {
+  (void)p0;
+  (void)p1;
+  (void)x0;
+  (void)x1;
+}
+
+void oled_mirror_drain(void) {}
+
+bool oled_mirror_busy(void) { return false; }
+
+#endif /* OLED_MIRROR_ENABLE */
@@ -0,0 +1,101 @@
+#include "oled_pm.h"
+#include "oled.h"
+#include "rtc.h"
+#include "trace.h"
+
+// 当前面板状态（仅主循环修改）
+static oled_pm_state_t s_state = OLED_PM_ON;
+// 最近一次操作的RTC计数（秒）
+static volatile uint32_t s_last_activity = 0;
+// 有新操作，面板需恢复正常亮度
+static volatile bool s_wake_pending = false;
+
+/**
+ * @brief 面板初始化完成后调用：正常亮度并开始无操作计时
+ * @note  亮度命令排不进显示队列时按已调暗处理，由oled_pm_poll重试
+ */
+void oled_pm_init(void) {
+  bool ok = OLED_IntensityControl(OLED_PM_BRIGHT);
+  s_state = ok ? OLED_PM_ON : OLED_PM_DIM;
+  s_last_activity = RTC_GetCounter();
+  s_wake_pending = !ok;
+}
+
+/**
+ * @brief 记录一次操作（按键、模块数据等），可在中断中调用
+ * @note  只置标志，I2C命令由oled_pm_poll在主循环中发送
+ */
+void oled_pm_activity(void) {
+  s_last_activity = RTC_GetCounter();
+  s_wake_pending = true;
+}
+
+/**
+ * @brief 执行亮度策略（主循环调用，在OLED_Refresh之前）
+ * @note  关屏只关闭显示与电荷泵，GDDRAM保持；关屏期间的绘制照常刷新到面板，
+ *        唤醒时直接开显示，不需要重绘
+ * @note  命令排不进显示队列（刚提交了一大帧）时状态不变，下次调用重试
+ */
+void oled_pm_poll(void) {
+  uint32_t idle;
+
+  if (s_wake_pending) {
+    if (s_state == OLED_PM_OFF) {
+      if (!OLED_Display_On()) {
+        return;
+      }
+      s_state = OLED_PM_DIM; // 已开显示，亮度仍是调暗值
+    }
+    if (s_state != OLED_PM_ON) {
+      if (!OLED_IntensityControl(OLED_PM_BRIGHT)) {
+        return;
+      }
+      s_state = OLED_PM_ON;
+      TRACE(TRACE_EV_OLED_PM, OLED_PM_ON, 0);
+    }
+    s_wake_pending = false;
+    return;
+  }
+
+  idle = RTC_GetCounter() - s_last_activity;
+  if (s_state == OLED_PM_ON && idle >= OLED_PM_DIM_S &&
+      OLED_IntensityControl(OLED_PM_DIMMED)) {
+    s_state = OLED_PM_DIM;
+    TRACE(TRACE_EV_OLED_PM, OLED_PM_DIM, idle);
+  }
+  if (s_state == OLED_PM_DIM && idle >= OLED_PM_OFF_S && OLED_Display_Off()) {
+    s_state = OLED_PM_OFF;
+    TRACE(TRACE_EV_OLED_PM, OLED_PM_OFF, idle);
+  }
+}
+
+/**
+ * @brief 下一次状态切换的RTC计数（供Stop前设置闹钟）
+ * @return uint32_t RTC计数，已关屏时返回UINT32_MAX
+ */
+uint32_t oled_pm_deadline(void) {
+  switch (s_state) {
+  case OLED_PM_ON:
+    return s_last_activity + OLED_PM_DIM_S;
+  case OLED_PM_DIM:
+    return s_last_activity + OLED_PM_OFF_S;
+  default:
+    return UINT32_MAX;
+  }
+}
+
+/**
+ * @brief 是否有待执行的亮度切换（有则主循环不应进入Stop）
+ */
+bool oled_pm_busy(void) {
+  if (s_wake_pending) {
+    return true;
+  }
+  return s_state != OLED_PM_OFF &&
+         (int32_t)(RTC_GetCounter() - oled_pm_deadline()) >= 0;
+}
+
+/**
+ * @brief 当前面板状态
+ */
+oled_pm_state_t oled_pm_state(void) { return s_state; }
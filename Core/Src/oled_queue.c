@@ -0,0 +1,358 @@
+#include "oled_queue.h"
+#include "dwt.h"
+#include "oled_i2c.h"
+#include "trace.h"
+#include <string.h>
+
+#define OLED_QUEUE_MASK (OLED_QUEUE_OPS - 1U)
+#define OLED_QUEUE_NO_ARENA 0xFFFFU // 操作不占用数据区
+
+// 一次I2C传输：控制字节 + 数据，连续存放，DMA一次发出
+typedef struct {
+  const uint8_t *buf;  // 发送内容（buf[0]为控制字节）：inline_buf或数据区
+  uint16_t len;        // 字节数（含控制字节）
+  uint16_t arena_end;  // 发送完后数据区的释放位置，OLED_QUEUE_NO_ARENA表示不占用
+  uint8_t ctrl;        // OLED_CTRL_CMD或OLED_CTRL_DATA
+  uint8_t inline_buf[1 + OLED_QUEUE_INLINE]; // 短命令的副本（含控制字节）
+  oled_queue_fence_cb_t fence; // 非NULL时为标记操作：不发送，执行到此时调用
+  void *fence_arg;
+} oled_op_t;
+
+volatile oled_queue_stats_t oled_queue_stats = {0};
+
+// 操作环：主循环只写s_head，中断只写s_tail，计数差即排队数（uint8_t回绕，OLED_QUEUE_OPS整除256）
+static oled_op_t s_ops[OLED_QUEUE_OPS];
+static volatile uint8_t s_head = 0;
+static volatile uint8_t s_tail = 0;
+// DMA链进行中：队列空闲时由主循环置位，排空时由中断清除
+static volatile bool s_running = false;
+// DMA链停在队首的标记处，由主循环oled_queue_poll执行标记回调后继续
+static volatile bool s_fence_ready = false;
+// 有操作发送失败，面板内容可能与显存不一致
+static volatile bool s_error = false;
+// 命令发送失败后跳过紧随的数据，直到下一条命令（窗口未设置时数据会写到错误的位置）
+static bool s_skip_data = false;
+
+// 数据区：按分配顺序环形使用，放不下时从头开始（尾部剩余空间本轮不用）；
+// s_arena_head == s_arena_tail表示全部空闲
+static uint8_t s_arena[OLED_QUEUE_ARENA];
+static uint16_t s_arena_head = 0;          // 分配位置（主循环）
+static volatile uint16_t s_arena_tail = 0; // 释放位置（中断）
+static uint16_t s_reserve_off = 0;         // oled_queue_reserve分配、尚未提交的区域
+static uint16_t s_reserve_len = 0;
+
+// 本次排空的开始时刻与已发送字节数（中断与启动发送的主循环使用）
+static uint32_t s_drain_start = 0;
+static uint32_t s_drain_bytes = 0;
+
+static void oled_queue_next(void);
+
+/**
+ * @brief 当前排队的操作数（含正在发送的一条）
+ */
+static uint8_t oled_queue_count(void) { return (uint8_t)(s_head - s_tail); }
+
+/**
+ * @brief 一条操作发送结束（成功或失败），释放其数据区
+ */
+static void oled_queue_retire(const oled_op_t *op) {
+  if (op->arena_end != OLED_QUEUE_NO_ARENA) {
+    s_arena_tail = op->arena_end;
+  }
+  s_tail++;
+}
+
+/**
+ * @brief DMA完成回调（I2C中断上下文）：结束当前操作并立即启动下一条
+ */
+static void oled_queue_done(bool ok, void *arg) {
+  const oled_op_t *op = arg;
+  if (ok) {
+    s_drain_bytes += op->len - 1U;
+  } else {
+    oled_queue_stats.error_count++;
+    s_error = true;
+    s_skip_data = true;
+  }
+  oled_queue_retire(op);
+  oled_queue_next();
+}
+
+/**
+ * @brief 启动队首操作的DMA传输，队列为空时结束本次排空并记录耗时
+ * @note  由启动发送的主循环、执行标记的主循环或DMA完成中断调用，同一时刻只有一方执行
+ */
+static void oled_queue_next(void) {
+  while (s_head != s_tail) {
+    oled_op_t *op = &s_ops[s_tail & OLED_QUEUE_MASK];
+    if (op->fence != NULL) {
+      s_fence_ready = true; // 之前的操作均已结束（发送或丢弃），回调交给主循环
+      return;
+    }
+    if (op->ctrl != OLED_CTRL_DATA) {
+      s_skip_data = false;
+    } else if (s_skip_data) {
+      oled_queue_retire(op); // 整屏重发时会补上
+      continue;
+    }
+    if (oled_i2c_write_dma(op->buf, op->len, oled_queue_done, op)) {
+      return;
+    }
+    // 无法启动（总线被阻塞传输占用或HAL出错）：丢弃该操作，继续后面的
+    oled_queue_stats.error_count++;
+    s_error = true;
+    s_skip_data = true;
+    oled_queue_retire(op);
+  }
+
+  uint32_t us = dwt_cycles_to_us(dwt_cycles() - s_drain_start);
+  oled_queue_stats.drain_count++;
+  oled_queue_stats.drain_bytes_last = s_drain_bytes;
+  oled_queue_stats.drain_us_last = us;
+  if (us > oled_queue_stats.drain_us_max) {
+    oled_queue_stats.drain_us_max = us;
+  }
+  TRACE(TRACE_EV_OLED_DRAIN, s_drain_bytes, us);
+  s_running = false;
+}
+
+/**
+ * @brief 使队首空位中已填好的操作对中断可见，DMA链空闲时从主循环启动发送
+ */
+static void oled_queue_publish(void) {
+  s_head++; // 操作内容写完后才对中断可见
+
+  uint8_t count = oled_queue_count();
+  if (count > oled_queue_stats.ops_max) {
+    oled_queue_stats.ops_max = count;
+  }
+  // 中断只在s_running为true时修改它，这里读到false时DMA链必然已停止
+  if (!s_running) {
+    s_running = true;
+    s_drain_start = dwt_cycles();
+    s_drain_bytes = 0;
+    oled_queue_next();
+  }
+}
+
+/**
+ * @brief 追加一条传输操作
+ * @param buf 控制字节 + 数据（buf[0]已填入ctrl）
+ * @param len 字节数（含控制字节）
+ */
+static void oled_queue_push(uint8_t ctrl, const uint8_t *buf, uint16_t len,
+                            uint16_t arena_end) {
+  oled_op_t *op = &s_ops[s_head & OLED_QUEUE_MASK];
+  op->ctrl = ctrl;
+  op->buf = buf;
+  op->len = len;
+  op->arena_end = arena_end;
+  op->fence = NULL;
+  oled_queue_publish();
+}
+
+/**
+ * @brief 操作环中是否还能放下ops条操作
+ * @param ops 操作数（如窗口命令+数据为2）
+ * @return bool true=有空位
+ */
+bool oled_queue_room(uint8_t ops) {
+  if (oled_queue_count() + ops <= OLED_QUEUE_OPS) {
+    return true;
+  }
+  oled_queue_stats.full_count++;
+  return false;
+}
+
+/**
+ * @brief 数据区是否能依次放下runs段、共bytes字节（每段另加1字节控制字节）
+ * @param runs  oled_queue_reserve的次数
+ * @param bytes 各段字节数之和
+ * @return bool true=之后依次分配必定成功
+ * @note  按连续的一段空闲区判断（回绕时尾部剩余空间不计），偏保守；
+ *        中断只会释放数据区，检查之后空间不会变少
+ */
+bool oled_queue_room_arena(uint8_t runs, uint16_t bytes) {
+  uint16_t tail = s_arena_tail;
+  uint32_t need = (uint32_t)bytes + runs;
+
+  if (tail == s_arena_head) { // 全部空闲，分配时回到开头
+    if (need <= OLED_QUEUE_ARENA) {
+      return true;
+    }
+  } else if (s_arena_head > tail) {
+    if (s_arena_head + need <= OLED_QUEUE_ARENA || need < tail) {
+      return true;
+    }
+  } else if (s_arena_head + need < tail) {
+    return true;
+  }
+  oled_queue_stats.full_count++;
+  return false;
+}
+
+/**
+ * @brief 在数据区分配len字节，由调用者填入后用oled_queue_commit提交为一条操作
+ * @param len 字节数（1~OLED_QUEUE_ARENA-1，另占1字节存放控制字节）
+ * @return uint8_t* 分配的区域；数据区放不下时返回NULL，稍后重试
+ * @note  分配到提交之间不能再追加其他数据区操作
+ */
+uint8_t *oled_queue_reserve(uint16_t len) {
+  uint16_t tail = s_arena_tail;
+  uint16_t off;
+
+  if (tail == s_arena_head) { // 全部空闲：回到开头，整块可用（中断已不会再修改s_arena_tail）
+    s_arena_head = s_arena_tail = tail = 0;
+  }
+  if (len == 0 || len >= OLED_QUEUE_ARENA) {
+    return NULL;
+  }
+  len++; // 控制字节放在数据之前，与数据一次发出
+  // 新的分配位置不能追上释放位置，否则无法与全部空闲区分
+  if (s_arena_head >= tail) {
+    if (s_arena_head + len <= OLED_QUEUE_ARENA) {
+      off = s_arena_head;
+    } else if (len < tail) {
+      off = 0;
+    } else {
+      oled_queue_stats.full_count++;
+      return NULL;
+    }
+  } else if (s_arena_head + len < tail) {
+    off = s_arena_head;
+  } else {
+    oled_queue_stats.full_count++;
+    return NULL;
+  }
+  s_reserve_off = off;
+  s_reserve_len = len;
+  return &s_arena[off + 1U];
+}
+
+/**
+ * @brief 将oled_queue_reserve分配的区域提交为一条操作
+ * @param ctrl OLED_CTRL_CMD或OLED_CTRL_DATA
+ * @note  调用前须确认oled_queue_room(1)
+ */
+void oled_queue_commit(uint8_t ctrl) {
+  uint16_t end = s_reserve_off + s_reserve_len;
+  uint16_t tail = s_arena_tail;
+  uint32_t used;
+
+  s_arena_head = end;
+  used = (end > tail) ? (uint32_t)(end - tail) : (uint32_t)(OLED_QUEUE_ARENA - tail + end);
+  if (used > oled_queue_stats.bytes_max) {
+    oled_queue_stats.bytes_max = used;
+  }
+  s_arena[s_reserve_off] = ctrl;
+  oled_queue_push(ctrl, &s_arena[s_reserve_off], s_reserve_len, end);
+}
+
+/**
+ * @brief 追加一次传输，数据复制到队列中，调用返回后buf即可复用
+ * @param ctrl OLED_CTRL_CMD（命令列表）或OLED_CTRL_DATA（显存数据）
+ * @param buf  数据
+ * @param len  字节数
+ * @return bool true=已排队；false=队列已满，未排队
+ */
+bool oled_queue_write(uint8_t ctrl, const uint8_t *buf, uint16_t len) {
+  if (len == 0) {
+    return true;
+  }
+  if (!oled_queue_room(1)) {
+    return false;
+  }
+  if (len <= OLED_QUEUE_INLINE) {
+    oled_op_t *op = &s_ops[s_head & OLED_QUEUE_MASK];
+    op->inline_buf[0] = ctrl;
+    memcpy(&op->inline_buf[1], buf, len);
+    oled_queue_push(ctrl, op->inline_buf, len + 1U, OLED_QUEUE_NO_ARENA);
+    return true;
+  }
+  uint8_t *dst = oled_queue_reserve(len);
+  if (dst == NULL) {
+    return false;
+  }
+  memcpy(dst, buf, len);
+  oled_queue_commit(ctrl);
+  return true;
+}
+
+/**
+ * @brief 追加一个标记：之前追加的操作全部结束后调用cb（主循环中由oled_queue_poll
+ *        调用，之前的操作已全部结束时在本函数中直接调用）
+ * @param cb  回调，不发送任何数据
+ * @param arg 回调参数
+ * @return bool true=已排队；false=队列已满，未排队
+ * @note  操作发送失败被丢弃时也会执行到标记，回调中用oled_queue_failed判断
+ */
+bool oled_queue_fence(oled_queue_fence_cb_t cb, void *arg) {
+  oled_op_t *op;
+
+  if (!oled_queue_room(1)) {
+    return false;
+  }
+  op = &s_ops[s_head & OLED_QUEUE_MASK];
+  op->ctrl = OLED_CTRL_CMD;
+  op->buf = NULL;
+  op->len = 0;
+  op->arena_end = OLED_QUEUE_NO_ARENA;
+  op->fence = cb;
+  op->fence_arg = arg;
+  oled_queue_publish();
+  oled_queue_poll();
+  return true;
+}
+
+/**
+ * @brief DMA链停在标记处时执行标记回调，再继续发送后面的操作
+ *        （主循环调用，OLED_Refresh中也会调用）
+ * @note  s_fence_ready置位时没有传输进行，中断不会同时修改队列
+ */
+void oled_queue_poll(void) {
+  if (!s_fence_ready) {
+    return;
+  }
+  oled_op_t *op = &s_ops[s_tail & OLED_QUEUE_MASK];
+  oled_queue_fence_cb_t fence = op->fence;
+  void *arg = op->fence_arg;
+  s_fence_ready = false;
+  oled_queue_retire(op);
+  fence(arg);
+  oled_queue_next();
+}
+
+/**
+ * @brief 阻塞等待队列全部发送完毕（阻塞写之前调用，保证与已排队的操作按顺序发出）
+ * @note  每条传输最长OLED_I2C_TIMEOUT_MS后由oled_i2c_poll按失败结束，
+ *        之后进入暂停发送，剩余操作直接丢弃，等待有上限
+ */
+void oled_queue_flush(void) {
+  while (s_running) {
+    oled_i2c_wait_idle();
+    oled_i2c_poll();
+    oled_queue_poll();
+  }
+}
+
+/**
+ * @brief 队列是否已全部发送完毕
+ */
+bool oled_queue_idle(void) { return !s_running; }
+
+/**
+ * @brief 是否有发送失败尚未被oled_queue_take_error取走
+ */
+bool oled_queue_failed(void) { return s_error; }
+
+/**
+ * @brief 取出并清除发送失败标志
+ * @return bool true=上次取出后有操作发送失败，面板内容需要整屏重发
+ */
+bool oled_queue_take_error(void) {
+  if (!s_error) {
+    return false;
+  }
+  s_error = false;
+  return true;
+}
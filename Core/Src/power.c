@@ -0,0 +1,209 @@
+#include "power.h"
+#include "dwt.h"
+#include "main.h"
+#include "oled_mirror.h"
+#include "oled_pm.h"
+#include "rtc.h"
+#include "swtimer.h"
+#include "tim.h"
+#include "trace.h"
+#include "usart.h"
+
+// HSI为Stop唤醒后的系统时钟（8MHz），PLL切换前的周期按此频率换算
+#define POWER_HSI_MHZ 8U
+// 外部晶振/PLL起振的最大轮询次数，超过则退回完整的时钟配置流程
+#define POWER_CLOCK_SPIN_MAX 100000U
+
+#define POWER_KEY_LINES (KEY0_Pin | KEY1_Pin | KEY2_Pin | KEY3_Pin)
+
+volatile power_stats_t power_stats = {0};
+
+// 上一次写入RTC闹钟寄存器的值，避免每次进入Stop都写备份域（RTC闹钟唤醒后作废）
+static uint32_t s_alarm_counter = 0;
+
+/**
+ * @brief 低功耗管理初始化（使能周期计数器，调试版本保持Stop下的调试连接）
+ */
+void power_init(void) {
+  dwt_init();
+#ifdef DEBUG
+  HAL_DBGMCU_EnableDBGStopMode(); // 调试时Stop模式下不断开SWD
+#endif
+}
+
+/**
+ * @brief 应用层空闲判断（弱定义，应用层覆盖以声明当前无操作进行中）
+ * @return bool true=应用层空闲，允许进入Stop
+ */
+__weak bool power_app_is_idle(void) { return true; }
+
+/**
+ * @brief 应用层下一次需要唤醒的RTC计数（弱定义，默认下一个整分，供时间行刷新）
+ * @param counter 当前RTC计数（秒）
+ * @return uint32_t 唤醒时刻的RTC计数，须晚于counter
+ */
+__weak uint32_t power_app_wakeup(uint32_t counter) {
+  return counter - (counter % 60U) + 60U;
+}
+
+/**
+ * @brief 判断当前是否可以进入Stop模式
+ * @return bool true=可以休眠；false=有操作进行中
+ * @note  需在关中断状态下调用，防止判断后中断置位新的事件
+ */
+bool power_can_sleep(void) {
+  // FM225上电期间模块随时会回传数据
+  if (FM225_CTL_GPIO_Port->ODR & FM225_CTL_Pin) {
+    return false;
+  }
+  // 按键扫描进行中（Stop下定时器停止，会丢失按键事件）
+  if (htim1.Instance->CR1 & TIM_CR1_CEN) {
+    return false;
+  }
+  // 软件定时器计时中（Stop下SysTick停止，定时会被拉长）
+  if (swtimer_pending() != 0) {
+    return false;
+  }
+  // 串口DMA发送未完成
+  if (huart1.gState != HAL_UART_STATE_READY) {
+    return false;
+  }
+  // 跟踪记录尚未发出
+  if (trace_busy()) {
+    return false;
+  }
+  // 面板镜像尚未发出
+  if (oled_mirror_busy()) {
+    return false;
+  }
+  return power_app_is_idle();
+}
+
+/**
+ * @brief 配置Stop期间的唤醒源：RTC闹钟定在应用层要求的时刻（默认整分）或面板调暗/关屏时刻，
+ *        USART1 RX下降沿
+ */
+static void power_arm_wakeup(void) {
+  uint32_t counter = RTC_GetCounter();
+  uint32_t alarm = power_app_wakeup(counter);
+  uint32_t deadline = oled_pm_deadline();
+  if (deadline - counter - 1U < alarm - counter - 1U) {
+    alarm = deadline; // 面板亮度切换更早（deadline已过时由power_can_sleep拦截）
+  }
+  if (alarm != s_alarm_counter) {
+    RTC_SetAlarm(alarm);
+    s_alarm_counter = alarm;
+  }
+
+  // PB7保持输入模式，仅将EXTI7映射到GPIOB并使能下降沿中断
+  MODIFY_REG(AFIO->EXTICR[1], AFIO_EXTICR2_EXTI7, 1U << AFIO_EXTICR2_EXTI7_Pos);
+  SET_BIT(EXTI->FTSR, POWER_UART_WAKE_Pin);
+  WRITE_REG(EXTI->PR, POWER_UART_WAKE_Pin);
+  SET_BIT(EXTI->IMR, POWER_UART_WAKE_Pin);
+}
+
+/**
+ * @brief 撤销串口唤醒线（运行时由USART接收中断处理数据）
+ */
+static void power_disarm_wakeup(void) {
+  CLEAR_BIT(EXTI->IMR, POWER_UART_WAKE_Pin);
+  CLEAR_BIT(EXTI->FTSR, POWER_UART_WAKE_Pin);
+}
+
+/**
+ * @brief 根据EXTI挂起位判断唤醒源（需在中断服务清除挂起位之前调用）
+ * @return uint8_t 唤醒源（POWER_WAKE_*按位组合）
+ */
+static uint8_t power_wake_source(void) {
+  uint32_t pending = EXTI->PR;
+  uint8_t source = POWER_WAKE_NONE;
+
+  if (pending & POWER_KEY_LINES) {
+    source |= POWER_WAKE_KEY;
+  }
+  if (pending & RTC_EXTI_LINE_ALARM_EVENT) {
+    source |= POWER_WAKE_RTC;
+  }
+  if (pending & POWER_UART_WAKE_Pin) {
+    source |= POWER_WAKE_UART;
+  }
+  return source;
+}
+
+/**
+ * @brief Stop唤醒后恢复HSE+PLL时钟树
+ * @note  PLL倍频、总线分频与Flash等待周期在Stop期间保持不变，只需重新使能
+ *        HSE和PLL并切换系统时钟；起振异常时退回SystemClock_Config完整流程
+ * @return uint32_t 切换到PLL时刻的周期计数
+ */
+static uint32_t power_restore_clock(void) {
+  uint32_t spin = 0;
+
+  __HAL_RCC_HSE_CONFIG(RCC_HSE_ON);
+  while (__HAL_RCC_GET_FLAG(RCC_FLAG_HSERDY) == RESET) {
+    if (++spin > POWER_CLOCK_SPIN_MAX) {
+      SystemClock_Config();
+      return dwt_cycles();
+    }
+  }
+
+  __HAL_RCC_PLL_ENABLE();
+  while (__HAL_RCC_GET_FLAG(RCC_FLAG_PLLRDY) == RESET) {
+    if (++spin > POWER_CLOCK_SPIN_MAX) {
+      SystemClock_Config();
+      return dwt_cycles();
+    }
+  }
+
+  __HAL_RCC_SYSCLK_CONFIG(RCC_SYSCLKSOURCE_PLLCLK);
+  while (__HAL_RCC_GET_SYSCLK_SOURCE() != RCC_SYSCLKSOURCE_STATUS_PLLCLK) {
+  }
+  return dwt_cycles();
+}
+
+/**
+ * @brief 空闲处理：无操作进行时进入Stop模式，由按键、RTC闹钟或串口唤醒
+ * @note  Stop模式下SRAM、寄存器与GPIO输出状态全部保持，唤醒后从此处继续执行；
+ *        关中断期间执行WFI，挂起的中断仍可唤醒内核，避免判断与休眠之间的竞争
+ */
+void power_idle(void) {
+  __disable_irq();
+  if (!power_can_sleep()) {
+    __enable_irq();
+    return;
+  }
+
+  power_arm_wakeup();
+  HAL_SuspendTick();
+  power_stats.stop_count++;
+  TRACE(TRACE_EV_STOP, power_stats.stop_count, 0);
+
+  HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+  // 唤醒后系统时钟为HSI，先记录时间戳和唤醒源
+  uint32_t t_wake = dwt_cycles();
+  power_stats.wake_source = power_wake_source();
+
+  uint32_t t_pll = power_restore_clock();
+  HAL_ResumeTick();
+  // Stop期间APB1停止，RTC的CNT/ALR影子寄存器要等RSF重新同步后才能读（RM0008），
+  // 否则RTC_GetCounter可能读到休眠前的值。LSE在Stop中照常运行，同步约需两个RTCCLK
+  // 周期，关中断下SysTick不走，HAL的超时不起作用，但等待本身有界
+  HAL_RTC_WaitForSynchro(&hrtc);
+  if (power_stats.wake_source & POWER_WAKE_RTC) {
+    s_alarm_counter = 0; // 闹钟已触发，下次进入Stop时重新设置
+  }
+  power_disarm_wakeup();
+  uint32_t t_ready = dwt_cycles();
+
+  // HSI段按8MHz换算，PLL段按SystemCoreClock换算
+  uint32_t us = (t_pll - t_wake) / POWER_HSI_MHZ +
+                dwt_cycles_to_us(t_ready - t_pll);
+  power_stats.wake_us_last = us;
+  if (us > power_stats.wake_us_max) {
+    power_stats.wake_us_max = us;
+  }
+  TRACE(TRACE_EV_WAKE, power_stats.wake_source, us);
+
+  __enable_irq(); // 挂起的按键/闹钟/串口中断在此之后依次得到服务
+}
@@ -0,0 +1,66 @@
+#include "progress.h"
+#include "oled.h"
+
+// 内部填充区域（外框内缩一列/一行空白）
+#define BAR_X0 2U
+#define BAR_X1 (OLED_WIDTH - 3U)
+#define BAR_WIDTH (BAR_X1 - BAR_X0 + 1U)
+
+static uint8_t s_page = 0;                 // 进度条所在页
+static uint32_t s_duration = 0;            // 总时长（毫秒），0表示未显示
+static uint32_t s_deadline = 0;            // 倒计时结束时刻（HAL_GetTick）
+static uint8_t s_fill_x1 = 0;              // 当前填充的结束列，< BAR_X0表示已空
+
+/**
+ * @brief 在指定页显示满格的倒计时进度条，之后按剩余时间缩短
+ * @param page        所在页（0~7），整页由进度条使用
+ * @param deadline    倒计时结束的时刻（HAL_GetTick），如模块命令的超时时刻
+ * @param duration_ms 满格对应的时长，剩余时间超过它时保持满格
+ */
+void progress_start(uint8_t page, uint32_t deadline, uint32_t duration_ms) {
+  uint8_t y = page * 8;
+
+  progress_stop();
+  s_page = page;
+  s_duration = duration_ms;
+  s_deadline = deadline;
+  s_fill_x1 = BAR_X1;
+
+  OLED_FillRect(0, y, OLED_WIDTH - 1, y + 7, OLED_CLEAR);
+  OLED_Rect(0, y + 1, OLED_WIDTH - 1, y + 7, OLED_SET);
+  OLED_FillRect(BAR_X0, y + 3, BAR_X1, y + 5, OLED_SET);
+}
+
+/**
+ * @brief 停止倒计时并清除进度条所在页
+ */
+void progress_stop(void) {
+  if (s_duration != 0) {
+    OLED_FillRect(0, s_page * 8, OLED_WIDTH - 1, s_page * 8 + 7, OLED_CLEAR);
+    s_duration = 0;
+  }
+}
+
+/**
+ * @brief 主循环调用（在OLED_Refresh之前）：按距截止时刻的剩余时间缩短填充
+ * @note  只清除新空出的列，刷新时只发送这几列
+ */
+void progress_poll(void) {
+  int32_t left;
+  uint32_t remain;
+  uint8_t x1;
+
+  if (s_duration == 0) {
+    return;
+  }
+  left = (int32_t)(s_deadline - HAL_GetTick()); // 计数回绕时按差值判断
+  remain = left <= 0 ? 0 : (uint32_t)left;
+  if (remain > s_duration) {
+    remain = s_duration;
+  }
+  x1 = (uint8_t)(BAR_X0 + (remain * BAR_WIDTH + s_duration - 1) / s_duration) - 1;
+  if (x1 < s_fill_x1) {
+    OLED_FillRect(x1 + 1, s_page * 8 + 3, s_fill_x1, s_page * 8 + 5, OLED_CLEAR);
+    s_fill_x1 = x1;
+  }
+}
@@ -0,0 +1,32 @@
+#include "rle.h"
+#include <string.h>
+
+/**
+ * @brief 解码一段游程编码数据，恰好输出dst_len字节
+ * @param src     编码数据
+ * @param dst     输出缓冲区
+ * @param dst_len 输出字节数（编码器按此长度分段，如显存一行）
+ * @return uint16_t 消耗的编码字节数，下一段紧接其后
+ * @note  重复段用memset、原样段用memcpy，不逐字节判断；
+ *        编码数据超出dst_len的部分被截断，不会越界写
+ */
+uint16_t rle_decode(const uint8_t *src, uint8_t *dst, uint16_t dst_len) {
+  const uint8_t *p = src;
+  uint16_t out = 0;
+
+  while (out < dst_len) {
+    uint8_t c = *p++;
+    uint16_t n = (uint16_t)(c & 0x7FU) + 1U;
+    if (n > dst_len - out) {
+      n = dst_len - out;
+    }
+    if (c & RLE_RUN_FLAG) {
+      memset(&dst[out], *p++, n);
+    } else {
+      memcpy(&dst[out], p, n);
+      p += (c & 0x7FU) + 1U;
+    }
+    out += n;
+  }
+  return (uint16_t)(p - src);
+}
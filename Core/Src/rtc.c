@@ -80,6 +80,32 @@ void RTC_GetTime(void)
     date_info[6] = time_date.tm_wday;
 }
 
+uint32_t RTC_GetCounter(void)
+{
+    uint16_t high, low;
+    // 两次读取高16位一致，保证低16位进位时读数正确
+    do
+    {
+        high = RTC->CNTH;
+        low = RTC->CNTL;
+    } while (high != RTC->CNTH);
+    return ((uint32_t)high << 16) | low;
+}
+void RTC_SetAlarm(uint32_t alarm_counter)
+{
+    // 计数器存放的是时间戳，HAL的闹钟接口按当天秒数计算，这里直接写闹钟寄存器
+    while ((hrtc.Instance->CRL & RTC_CRL_RTOFF) == (uint32_t)RESET);
+    __HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+    WRITE_REG(hrtc.Instance->ALRH, (alarm_counter >> 16U));
+    WRITE_REG(hrtc.Instance->ALRL, (alarm_counter & RTC_ALRL_RTC_ALR));
+    __HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+    while ((hrtc.Instance->CRL & RTC_CRL_RTOFF) == (uint32_t)RESET);
+    // 闹钟经EXTI17上升沿触发，可将MCU从Stop模式唤醒
+    __HAL_RTC_ALARM_CLEAR_FLAG(&hrtc, RTC_FLAG_ALRAF);
+    __HAL_RTC_ALARM_ENABLE_IT(&hrtc, RTC_IT_ALRA);
+    __HAL_RTC_ALARM_EXTI_ENABLE_IT();
+    __HAL_RTC_ALARM_EXTI_ENABLE_RISING_EDGE();
+}
 void rtc_init_user(void)
 {
     HAL_RTCEx_SetSecond_IT(&hrtc);                        // 秒中断使能，没有配置这个中断可以不加
@@ -163,7 +189,7 @@ void HAL_RTC_MspInit(RTC_HandleTypeDef* rtcHandle)
     __HAL_RCC_RTC_ENABLE();
 
     /* RTC interrupt Init */
-    HAL_NVIC_SetPriority(RTC_IRQn, 0, 0);
+    HAL_NVIC_SetPriority(RTC_IRQn, 1, 0);
     HAL_NVIC_EnableIRQ(RTC_IRQn);
     HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
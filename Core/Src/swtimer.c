@@ -0,0 +1,148 @@
+#include "swtimer.h"
+#include "trace.h"
+
+// 每个槽一个哨兵节点，空槽的哨兵指向自身
+static swtimer_t s_wheel[SWTIMER_WHEEL_SIZE];
+// 下一次SysTick要处理的槽
+static uint32_t s_cursor = 0;
+// 时间轮中的定时器数量
+static volatile uint32_t s_pending = 0;
+
+static inline void list_init(swtimer_t *head) {
+  head->next = head;
+  head->prev = head;
+}
+
+static inline void list_insert(swtimer_t *head, swtimer_t *node) {
+  node->next = head->next;
+  node->prev = head;
+  head->next->prev = node;
+  head->next = node;
+}
+
+static inline void list_remove(swtimer_t *node) {
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+  node->next = node;
+  node->prev = node;
+}
+
+/**
+ * @brief 将定时器挂入时间轮（调用者负责关中断）
+ * @param timer 定时器
+ * @param ms    延时（毫秒，0按1处理）
+ */
+static void swtimer_insert(swtimer_t *timer, uint32_t ms) {
+  if (ms == 0) {
+    ms = 1;
+  }
+  // 第ms次tick到期：落在(cursor + ms - 1)槽，再等待(ms - 1) / 槽数整圈
+  timer->rounds = (ms - 1U) >> SWTIMER_WHEEL_BITS;
+  list_insert(&s_wheel[(s_cursor + ms - 1U) & SWTIMER_WHEEL_MASK], timer);
+  timer->active = true;
+  s_pending++;
+}
+
+/**
+ * @brief 初始化时间轮（需在SysTick调用swtimer_tick之前完成）
+ */
+void swtimer_init(void) {
+  for (uint32_t i = 0; i < SWTIMER_WHEEL_SIZE; i++) {
+    list_init(&s_wheel[i]);
+  }
+  s_cursor = 0;
+  s_pending = 0;
+}
+
+/**
+ * @brief 启动（或重启）定时器，O(1)
+ * @param timer 定时器
+ * @param ms    延时（毫秒）
+ * @param cb    到期回调，在SysTick中断中执行，应只做置标志等短操作
+ * @param arg   回调参数
+ * @note  可在任意上下文（含中断和回调内部）调用
+ */
+void swtimer_start(swtimer_t *timer, uint32_t ms, swtimer_cb_t cb, void *arg) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (timer->active) {
+    list_remove(timer);
+    s_pending--;
+  }
+  timer->cb = cb;
+  timer->arg = arg;
+  swtimer_insert(timer, ms);
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 停止定时器，O(1)；未启动的定时器调用无副作用
+ * @param timer 定时器
+ */
+void swtimer_stop(swtimer_t *timer) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (timer->active) {
+    list_remove(timer);
+    timer->active = false;
+    s_pending--;
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 查询定时器是否在计时
+ */
+bool swtimer_active(const swtimer_t *timer) { return timer->active; }
+
+/**
+ * @brief 时间轮中的定时器数量（非0时SysTick不能停止）
+ */
+uint32_t swtimer_pending(void) { return s_pending; }
+
+/**
+ * @brief 时间轮推进一格（SysTick中断中每1ms调用一次）
+ * @note  SysTick为最低优先级，swtimer_start/stop可能在其他中断中打断本函数：
+ *        链表、rounds、active与s_pending的每次修改都在关中断下进行，
+ *        只在执行回调时开中断
+ */
+void swtimer_tick(void) {
+  swtimer_t expired;
+  swtimer_t *slot;
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  slot = &s_wheel[s_cursor];
+  s_cursor = (s_cursor + 1U) & SWTIMER_WHEEL_MASK;
+  // 空槽（或swtimer_init之前的SysTick）直接返回
+  if (slot->next == slot || slot->next == NULL) {
+    __set_PRIMASK(primask);
+    return;
+  }
+
+  // 整槽摘到临时链表，回调中启动/停止任意定时器都不会破坏遍历
+  expired.next = slot->next;
+  expired.prev = slot->prev;
+  expired.next->prev = &expired;
+  expired.prev->next = &expired;
+  list_init(slot);
+
+  while (expired.next != &expired) {
+    swtimer_t *timer = expired.next;
+    list_remove(timer);
+    if (timer->rounds != 0) {
+      timer->rounds--;
+      list_insert(slot, timer);
+    } else {
+      swtimer_cb_t cb = timer->cb;
+      void *arg = timer->arg;
+      timer->active = false;
+      s_pending--;
+      __set_PRIMASK(primask);
+      TRACE(TRACE_EV_SWTIMER, cb, arg);
+      cb(arg);
+      __disable_irq();
+    }
+  }
+  __set_PRIMASK(primask);
+}
@@ -0,0 +1,117 @@
+#include "trace.h"
+#include "dwt.h"
+#include "usart.h"
+#include <string.h>
+
+#if TRACE_ENABLE
+
+// 跟踪记录环形缓冲区
+static trace_record_t s_ring[TRACE_RING_SIZE];
+// 已预留的记录总数（写指针，只增不减，取低位作为下标）
+static volatile uint32_t s_head = 0;
+// 已发送的记录总数（读指针，仅主循环访问）
+static uint32_t s_tail = 0;
+// 尚未上报的丢失记录数（缓冲区被写满覆盖）
+static uint32_t s_dropped = 0;
+// DMA发送缓冲区（发送期间环形缓冲区可继续写入）
+static uint8_t s_tx[4 + TRACE_PACKET_MAX * sizeof(trace_record_t) + 1];
+
+/**
+ * @brief 写入一条跟踪记录（无锁，可在任意中断或主循环中调用）
+ * @param id   事件ID（TRACE_EV_*）
+ * @param arg0 参数0
+ * @param arg1 参数1
+ * @note  LDREX/STREX预留槽位，高优先级中断打断时各自取得不同槽位；
+ *        seq最后写入，读端据此判断记录是否已写完整
+ */
+void trace_record(uint16_t id, uint32_t arg0, uint32_t arg1) {
+  uint32_t idx;
+  do {
+    idx = __LDREXW((volatile uint32_t *)&s_head);
+  } while (__STREXW(idx + 1U, (volatile uint32_t *)&s_head) != 0U);
+
+  trace_record_t *rec = &s_ring[idx & TRACE_RING_MASK];
+  rec->cycles = dwt_cycles();
+  rec->id = id;
+  rec->ctx = (uint8_t)__get_IPSR();
+  rec->arg0 = arg0;
+  rec->arg1 = arg1;
+  __DMB();
+  rec->seq = (uint8_t)(idx + 1U);
+}
+
+/**
+ * @brief 将缓冲区中的记录打包经USART3 DMA发出（主循环调用）
+ * @note  上一帧未发送完成时直接返回；帧格式见TRACE_SYNC0
+ */
+void trace_drain(void) {
+  if (huart3.gState != HAL_UART_STATE_READY) {
+    return;
+  }
+
+  uint32_t head = s_head;
+  // 写端已超过读端一整圈，最旧的记录已被覆盖
+  if (head - s_tail > TRACE_RING_SIZE) {
+    s_dropped += head - s_tail - TRACE_RING_SIZE;
+    s_tail = head - TRACE_RING_SIZE;
+  }
+
+  uint8_t count = 0;
+  while (s_tail != head && count < TRACE_PACKET_MAX) {
+    const trace_record_t *rec = &s_ring[s_tail & TRACE_RING_MASK];
+    uint8_t seq = (uint8_t)(s_tail + 1U);
+    if (rec->seq != seq) {
+      break; // 写入尚未完成，下次再取
+    }
+    memcpy(&s_tx[4 + count * sizeof(trace_record_t)], rec,
+           sizeof(trace_record_t));
+    __DMB();
+    s_tail++;
+    if (rec->seq != seq) {
+      s_dropped++; // 复制期间被中断覆盖
+      continue;
+    }
+    count++;
+  }
+
+  if (count == 0 && s_dropped == 0) {
+    return;
+  }
+
+  uint16_t len = 4 + count * sizeof(trace_record_t);
+  s_tx[0] = TRACE_SYNC0;
+  s_tx[1] = TRACE_SYNC1;
+  s_tx[2] = count;
+  s_tx[3] = (s_dropped > 0xFF) ? 0xFF : (uint8_t)s_dropped;
+  s_dropped -= s_tx[3];
+
+  // 与FM225协议相同的异或校验，从记录数开始计算
+  uint8_t bcc = 0;
+  for (uint16_t i = 2; i < len; i++) {
+    bcc ^= s_tx[i];
+  }
+  s_tx[len++] = bcc;
+
+  HAL_UART_Transmit_DMA(&huart3, s_tx, len);
+}
+
+/**
+ * @brief 是否有跟踪数据尚未发出（有则不进入Stop，避免DMA发送被中断）
+ */
+bool trace_busy(void) {
+  return huart3.gState != HAL_UART_STATE_READY || s_tail != s_head;
+}
+
+#else
+
+void trace_record(uint16_t id, uint32_t arg0, uint32_t arg1) {
+  (void)id;
+  (void)arg0;
+  (void)arg1;
+}
+
+void trace_drain(void) {}
+
+bool trace_busy(void) { return false; }
+
+#endif /* TRACE_ENABLE */
@@ -0,0 +1,62 @@
+"""Minimal BDF reader shared by the OLED asset generators.
+
+Glyphs are placed in a 16x16 cell (baseline at FONT_ASCENT) and returned in the
+SSD1306 page layout used by the firmware: two 16-byte halves (rows 0-7, 8-15),
+one byte per column, LSB at the top.
+"""
+
+import sys
+
+CELL = 16
+
+
+def load_bdf(path):
+    """Return {codepoint: (top[16], bottom[16])} for every glyph in the font."""
+    glyphs = {}
+    ascent = CELL - 2
+    encoding = None
+    bbx = None
+    rows = None
+    with open(path, encoding="latin-1") as f:
+        for lineno, line in enumerate(f, 1):
+            words = line.split()
+            if not words:
+                continue
+            key = words[0]
+            if key == "FONT_ASCENT":
+                ascent = int(words[1])
+            elif key == "ENCODING":
+                encoding = int(words[1])
+            elif key == "BBX":
+                bbx = [int(w) for w in words[1:5]]
+            elif key == "BITMAP":
+                rows = []
+            elif key == "ENDCHAR":
+                if encoding is not None and encoding >= 0 and bbx:
+                    glyphs[encoding] = to_pages(rows, bbx, ascent,
+                                                "%s:%d" % (path, lineno))
+                encoding = bbx = rows = None
+            elif rows is not None:
+                rows.append(int(key, 16) if key else 0)
+    return glyphs
+
+
+def to_pages(rows, bbx, ascent, where):
+    width, height, xoff, yoff = bbx
+    if width > CELL or height > CELL:
+        sys.exit("%s: glyph %dx%d does not fit a %dx%d cell"
+                 % (where, width, height, CELL, CELL))
+    top = [0] * CELL
+    bottom = [0] * CELL
+    row_bits = (width + 7) // 8 * 8
+    y0 = ascent - (yoff + height)  # cell row of the bitmap's first row
+    for r, bits in enumerate(rows[:height]):
+        y = y0 + r
+        if not 0 <= y < CELL:
+            continue
+        half = top if y < 8 else bottom
+        for c in range(width):
+            x = xoff + c
+            if 0 <= x < CELL and bits >> (row_bits - 1 - c) & 1:
+                half[x] |= 1 << (y % 8)
+    return top, bottom
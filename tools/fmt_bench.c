@@ -0,0 +1,140 @@
+/*
+ * Host check and benchmark for the display formatter (Core/Src/fmt.c).
+ *
+ *   cc -O2 -ICore/Inc tools/fmt_bench.c Core/Src/fmt.c -o /tmp/fmt_bench
+ *   /tmp/fmt_bench
+ *
+ * Checks fmt_u32/fmt_i32/fmt_fixed against snprintf over a range of values
+ * (and that fmt_u32 writes an empty string for a base outside 2..16), then
+ * times the clock line ("YYYY-MM-DD HH:MM") built with sprintf and with
+ * fmt_u32, and a 2-digit OLED_ShowNum digit loop with the old per-digit
+ * oled_pow() division against fmt_u32. Host timings only show the relative
+ * cost; the code size that matters is the linked firmware's .map.
+ */
+#include "fmt.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 2000000
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int fail(const char *what, const char *got, const char *want) {
+  fprintf(stderr, "%s: got \"%s\", want \"%s\"\n", what, got, want);
+  return 1;
+}
+
+static int check(void) {
+  static const int32_t values[] = {0,    1,      -1,      7,         -7,
+                                   42,   -42,    999,     1000,      -1234,
+                                   9999, 123456, -654321, 2147483647, -2147483647 - 1};
+  char got[64], want[64];
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    int32_t v = values[i];
+    for (uint8_t w = 0; w < 13; w++) {
+      fmt_u32(got, (uint32_t)v, w, '0', 10);
+      snprintf(want, sizeof(want), "%0*u", w, (unsigned)v);
+      if (strcmp(got, want)) return fail("u32 '0'", got, want);
+      fmt_u32(got, (uint32_t)v, w, ' ', 16);
+      snprintf(want, sizeof(want), "%*X", w, (unsigned)v);
+      if (strcmp(got, want)) return fail("u32 hex", got, want);
+      fmt_i32(got, v, w, '0');
+      snprintf(want, sizeof(want), "%0*d", w, (int)v);
+      if (strcmp(got, want)) return fail("i32 '0'", got, want);
+      fmt_i32(got, v, w, ' ');
+      snprintf(want, sizeof(want), "%*d", w, (int)v);
+      if (strcmp(got, want)) return fail("i32 ' '", got, want);
+      for (uint8_t d = 0; d < 4; d++) {
+        long long scale = 1;
+        for (uint8_t k = 0; k < d; k++) scale *= 10;
+        long long mag = llabs((long long)v);
+        fmt_fixed(got, v, d, w, ' ');
+        if (d == 0)
+          snprintf(want, sizeof(want), "%*lld", w, (long long)v);
+        else
+          snprintf(want, sizeof(want), "%s%lld.%0*lld", v < 0 ? "-" : "",
+                   mag / scale, d, mag % scale);
+        if (d > 0 && (int)strlen(want) < w) {
+          char tmp[64];
+          snprintf(tmp, sizeof(tmp), "%*s", w, want);
+          strcpy(want, tmp);
+        }
+        if (strcmp(got, want)) return fail("fixed", got, want);
+      }
+    }
+  }
+  static const uint8_t bad_bases[] = {0, 1, 17, 255};
+  for (size_t i = 0; i < sizeof(bad_bases) / sizeof(bad_bases[0]); i++) {
+    strcpy(got, "x");
+    if (fmt_u32(got, 42, 4, '0', bad_bases[i]) != got || got[0] != '\0')
+      return fail("u32 bad base", got, "");
+  }
+  return 0;
+}
+
+__attribute__((noinline)) static unsigned int oled_pow(unsigned char m, unsigned char n) {
+  unsigned int result = 1;
+  while (n--) result *= m;
+  return result;
+}
+
+int main(void) {
+  if (check()) return 1;
+  printf("fmt: all values match snprintf\n");
+
+  volatile unsigned short date[5] = {2025, 9, 13, 18, 45};
+  char buf[50];
+  volatile char sink = 0;
+
+  double t0 = now_ns();
+  for (int n = 0; n < ROUNDS; n++) {
+    sprintf(buf, "%04d-%02d-%02d %02d:%02d", date[0], date[1], date[2],
+            date[3], date[4]);
+    sink ^= buf[15];
+  }
+  double t_sprintf = (now_ns() - t0) / ROUNDS;
+
+  t0 = now_ns();
+  for (int n = 0; n < ROUNDS; n++) {
+    char *p = buf;
+    p = fmt_u32(p, date[0], 4, '0', 10);
+    *p++ = '-';
+    p = fmt_u32(p, date[1], 2, '0', 10);
+    *p++ = '-';
+    p = fmt_u32(p, date[2], 2, '0', 10);
+    *p++ = ' ';
+    p = fmt_u32(p, date[3], 2, '0', 10);
+    *p++ = ':';
+    fmt_u32(p, date[4], 2, '0', 10);
+    sink ^= buf[15];
+  }
+  double t_fmt = (now_ns() - t0) / ROUNDS;
+
+  volatile unsigned int num = 37;
+  volatile unsigned char len = 2;
+  t0 = now_ns();
+  for (int n = 0; n < ROUNDS; n++) {
+    for (unsigned char t = 0; t < len; t++)
+      buf[t] = (num / oled_pow(10, len - t - 1)) % 10 + '0';
+    sink ^= buf[1];
+  }
+  double t_pow = (now_ns() - t0) / ROUNDS;
+
+  t0 = now_ns();
+  for (int n = 0; n < ROUNDS; n++) {
+    fmt_u32(buf, num, len, ' ', 10);
+    sink ^= buf[1];
+  }
+  double t_num = (now_ns() - t0) / ROUNDS;
+
+  printf("clock line: sprintf %.1f ns, fmt_u32 %.1f ns\n", t_sprintf, t_fmt);
+  printf("2-digit number: oled_pow loop %.1f ns, fmt_u32 %.1f ns\n", t_pow,
+         t_num);
+  return 0;
+}
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Build the runtime CJK glyph table from the UTF-8 strings used in the firmware.
+
+Usage (run by CMake at build time):
+    gen_font.py --bdf assets/fonts/ui16.bdf --strings assets/strings.txt \\
+                --out-c font_cjk.c --out-h font_cjk.h Core/Src/*.c Core/Inc/*.h
+
+Every non-ASCII character inside a C string literal of the given sources, and in
+every language's text of each strings.txt ID the sources reference as STR_<ID>,
+is looked up in the BDF font and emitted once, sorted by codepoint, so the
+firmware can binary-search it (oled.c). All languages share this one table.
+Comments are ignored. A character with no glyph in the font fails the build.
+Static screens are baked by gen_screens.py and do not need entries here.
+"""
+
+import argparse
+import sys
+
+from bdf_font import load_bdf
+from ui_strings import load_strings
+
+
+def tokens(text):
+    """Yield (line, "str", literal) for every "..." and (line, "id", name) for every
+    identifier in C source, skipping comments."""
+    i = 0
+    line = 1
+    n = len(text)
+    while i < n:
+        c = text[i]
+        if c == "\n":
+            line += 1
+            i += 1
+        elif text.startswith("//", i):
+            i = text.find("\n", i)
+            if i < 0:
+                return
+        elif text.startswith("/*", i):
+            end = text.find("*/", i + 2)
+            end = n if end < 0 else end + 2
+            line += text.count("\n", i, end)
+            i = end
+        elif c in "\"'":
+            start = i + 1
+            i += 1
+            while i < n and text[i] != c and text[i] != "\n":
+                i += 2 if text[i] == "\\" else 1
+            if c == '"':
+                yield line, "str", text[start:i]
+            i += 1
+        elif c.isalpha() or c == "_":
+            start = i
+            while i < n and (text[i].isalnum() or text[i] == "_"):
+                i += 1
+            yield line, "id", text[start:i]
+        else:
+            i += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--bdf", required=True, help="16px BDF font")
+    parser.add_argument("--strings", help="strings.txt (texts of the STR_* IDs used)")
+    parser.add_argument("--out-c", required=True)
+    parser.add_argument("--out-h", required=True)
+    parser.add_argument("sources", nargs="*", help="C sources to scan")
+    args = parser.parse_args()
+
+    langs, strings = load_strings(args.strings) if args.strings else ([], {})
+    used = {}
+    for path in args.sources:
+        with open(path, encoding="utf-8") as f:
+            text = f.read()
+        for line, kind, value in tokens(text):
+            where = "%s:%d" % (path, line)
+            if kind == "str":
+                texts = [value]
+            elif value.startswith("STR_") and value[4:] in strings:
+                texts = [strings[value[4:]][lang] for lang in langs]
+                where += " (%s)" % value
+            else:
+                continue
+            for literal in texts:
+                for ch in literal:
+                    if ord(ch) > 0x7F:
+                        used.setdefault(ord(ch), where)
+
+    font = load_bdf(args.bdf)
+    missing = [(cp, where) for cp, where in sorted(used.items()) if cp not in font]
+    for cp, where in missing:
+        print("%s: no glyph for '%s' (U+%04X) in %s" % (where, chr(cp), cp, args.bdf),
+              file=sys.stderr)
+    if missing:
+        sys.exit(1)
+    if any(cp > 0xFFFF for cp in used):
+        sys.exit("gen_font: only BMP characters are supported")
+
+    codes = sorted(used)
+    size = max(len(codes), 1)  # C has no zero-length arrays
+    name = args.bdf.replace("\\", "/").split("/")[-1]
+    c = ["/* 由tools/gen_font.py根据%s与源码中用到的UTF-8字符串生成，请勿手动修改 */" % name,
+         '#include "font_cjk.h"', "",
+         "const uint16_t font_cjk_codes[%d] = {" % size]
+    c += ["    0x%04X, // %s" % (cp, chr(cp)) for cp in codes] or ["    0x0000,"]
+    c += ["};", "", "const uint8_t font_cjk_glyphs[%d][32] = {" % size]
+    for cp in codes:
+        top, bottom = font[cp]
+        c.append("    {" + ",".join("0x%02X" % b for b in top + bottom) + "}, // %s" % chr(cp))
+    if not codes:
+        c.append("    {0},")
+    c += ["};", ""]
+
+    h = ["/* 由tools/gen_font.py生成，请勿手动修改 */",
+         "#ifndef FONT_CJK_H_", "#define FONT_CJK_H_", "",
+         "#include <stdint.h>", "",
+         "// 字形数（按码位升序排列，二分查找）",
+         "#define FONT_CJK_COUNT %d" % len(codes), "",
+         "// 每个字形32字节：前16字节为上半页，后16字节为下半页（与显存布局相同）",
+         "extern const uint16_t font_cjk_codes[%d];" % size,
+         "extern const uint8_t font_cjk_glyphs[%d][32];" % size, "",
+         "#endif /* FONT_CJK_H_ */", ""]
+
+    with open(args.out_c, "w", encoding="utf-8") as f:
+        f.write("\n".join(c))
+    with open(args.out_h, "w", encoding="utf-8") as f:
+        f.write("\n".join(h))
+    print("gen_font: %d glyphs, %d bytes" % (len(codes), len(codes) * 34))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+"""Render the static OLED screens in assets/screens.txt into page-packed bitmaps.
+
+Usage (run by CMake at build time):
+    gen_screens.py --font Core/Src/oledfont.c --bdf assets/fonts/ui16.bdf \\
+                   --layout assets/screens.txt --strings assets/strings.txt \\
+                   --out-c build/generated/screens.c --out-h build/generated/screens.h
+
+Layout items name a string ID from strings.txt; every screen is rendered once per
+language, and the firmware picks the current language's table (Core/Inc/lang.h).
+An item's x is a column, or "c" to center the text on the screen.
+
+Glyphs:
+  ASCII      F8X16[] in oledfont.c, 16 bytes per character from ' ' (8 top, 8 bottom)
+  others     16x16 from the BDF font (see bdf_font.py)
+
+Each screen covers whole pages [first, last] and is emitted as (last - first + 1)
+rows of 128 bytes, the same layout as OLED_GRAM, so showing it is a row copy.
+With --rle every row is run-length encoded on its own (format in Core/Inc/rle.h)
+and the firmware decodes it row by row into the framebuffer.
+
+--dump PREFIX also writes PREFIX.raw (all rows) and PREFIX.rle (all encoded rows)
+for the host decoder benchmark, tools/rle_bench.c.
+"""
+
+import argparse
+import re
+import sys
+
+from bdf_font import load_bdf
+from ui_strings import load_strings
+
+WIDTH = 128
+PAGES = 8
+
+HEX = re.compile(r"0x([0-9A-Fa-f]{2})")
+
+
+def table_body(source, name):
+    """Return the text between the braces of `const unsigned char <name>...= {`."""
+    m = re.search(r"const\s+unsigned\s+char\s+%s\s*\[[^=]*=\s*\{" % name, source)
+    if not m:
+        sys.exit("gen_screens: table %s not found" % name)
+    depth = 1
+    i = m.end()
+    while depth:
+        if source[i] == "{":
+            depth += 1
+        elif source[i] == "}":
+            depth -= 1
+        i += 1
+    return source[m.end():i - 1]
+
+
+def load_ascii(path):
+    with open(path, encoding="utf-8") as f:
+        source = f.read()
+
+    ascii_data = [int(h, 16) for h in
+                  HEX.findall(re.sub(r"//.*", "", table_body(source, "F8X16")))]
+    f8x16 = {}
+    for n in range(len(ascii_data) // 16):
+        glyph = ascii_data[n * 16:n * 16 + 16]
+        f8x16[chr(ord(" ") + n)] = (glyph[:8], glyph[8:])
+    return f8x16
+
+
+def parse_layout(path):
+    screens = []
+    with open(path, encoding="utf-8") as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.rstrip("\n")
+            if not line.strip() or line.lstrip().startswith("#"):
+                continue
+            where = "%s:%d" % (path, lineno)
+            m = re.match(r"\[(\w+)\s+(\d+)\s+(\d+)\]\s*$", line.strip())
+            if m:
+                first, last = int(m.group(2)), int(m.group(3))
+                if not first <= last < PAGES:
+                    sys.exit("%s: bad page range" % where)
+                screens.append((m.group(1), first, last, [], where))
+                continue
+            m = re.match(r"(\d+|c)\s+(\d+)\s+([A-Z][A-Z0-9_]*)$", line.strip())
+            if not m or not screens:
+                sys.exit("%s: expected '[name first last]' or 'x page STRING_ID'" % where)
+            x = None if m.group(1) == "c" else int(m.group(1))
+            screens[-1][3].append((x, int(m.group(2)), m.group(3), where))
+    return screens
+
+
+def render(screen, lang, texts, cjk, f8x16):
+    name, first, last, items, _ = screen
+    gram = [[0] * WIDTH for _ in range(last - first + 1)]
+    for x, page, sid, where in items:
+        if page < first or page + 1 > last:
+            sys.exit("%s: text rows %d-%d outside [%s %d %d]"
+                     % (where, page, page + 1, name, first, last))
+        if sid not in texts:
+            sys.exit("%s: unknown string ID %s" % (where, sid))
+        text = texts[sid]
+        if x is None:
+            width = sum(8 if ch in f8x16 else 16 for ch in text)
+            x = max((WIDTH - width) // 2, 0)
+        for ch in text:
+            glyph = f8x16.get(ch) or cjk.get(ord(ch))
+            if glyph is None:
+                sys.exit("%s: no glyph for '%s' (%s %s) in F8X16 or the BDF font"
+                         % (where, ch, lang, sid))
+            top, bottom = glyph
+            if x + len(top) > WIDTH:
+                sys.exit("%s: %s text of %s runs past column %d" % (where, lang, sid, WIDTH - 1))
+            for i in range(len(top)):
+                gram[page - first][x + i] = top[i]
+                gram[page + 1 - first][x + i] = bottom[i]
+            x += len(top)
+    return gram
+
+
+def rle_encode(row):
+    """Encode one row: runs of 3+ equal bytes (2+ between literals) as repeats."""
+    out = bytearray()
+    literal = bytearray()
+
+    def flush():
+        while literal:
+            chunk = literal[:128]
+            del literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(row):
+        j = i
+        while j < len(row) and row[j] == row[i] and j - i < 128:
+            j += 1
+        run = j - i
+        if run >= 3 or (run == 2 and not literal):
+            flush()
+            out.append(0x80 | (run - 1))
+            out.append(row[i])
+            i = j
+        else:
+            literal.append(row[i])
+            i += 1
+    flush()
+    return out
+
+
+def c_bytes(data, indent):
+    return [indent + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ","
+            for i in range(0, len(data), 16)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--font", required=True, help="oledfont.c")
+    parser.add_argument("--bdf", required=True, help="16px BDF font")
+    parser.add_argument("--layout", required=True, help="screens.txt")
+    parser.add_argument("--strings", required=True, help="strings.txt")
+    parser.add_argument("--out-c", required=True)
+    parser.add_argument("--out-h", required=True)
+    parser.add_argument("--rle", action="store_true", help="run-length encode screens")
+    parser.add_argument("--dump", metavar="PREFIX", help="write raw/RLE rows for rle_bench")
+    args = parser.parse_args()
+
+    f8x16 = load_ascii(args.font)
+    cjk = load_bdf(args.bdf)
+    screens = parse_layout(args.layout)
+    langs, strings = load_strings(args.strings)
+    layout_name = args.layout.split("/")[-1]
+
+    c = ["/* 由tools/gen_screens.py根据%s生成，请勿手动修改 */" % layout_name,
+         '#include "screens.h"', ""]
+    h = ["/* 由tools/gen_screens.py根据%s生成，请勿手动修改 */" % layout_name,
+         "#ifndef SCREENS_H_", "#define SCREENS_H_", "", '#include "oled.h"',
+         '#include "strtab.h"', "", "// 界面ID（布局见screens.txt，每种语言各预渲染一份）",
+         "typedef enum {"]
+    raw_total = 0
+    rle_total = 0
+    raw_dump = bytearray()
+    rle_dump = bytearray()
+    for lang in langs:
+        texts = {sid: t[lang] for sid, t in strings.items()}
+        for screen in screens:
+            name, first, last, items, _ = screen
+            gram = render(screen, lang, texts, cjk, f8x16)
+            encoded = bytearray()
+            for row in gram:
+                encoded += rle_encode(row)
+                raw_dump += bytes(row)
+            rle_dump += encoded
+            raw_total += len(gram) * WIDTH
+            rle_total += len(encoded)
+            sym = "%s_%s" % (name, lang)
+            c.append("// %s" % " / ".join(texts[sid] for _, _, sid, _ in items))
+            if args.rle:
+                c.append("static const uint8_t %s_rle[%d] = {" % (sym, len(encoded)))
+                c += c_bytes(encoded, "    ")
+                c.append("};")
+                c.append("static const oled_screen_t scr_%s = {.first_page = %d, "
+                         ".last_page = %d, .rle_size = %d, .data = %s_rle};"
+                         % (sym, first, last, len(encoded), sym))
+            else:
+                c.append("static const uint8_t %s_bmp[%d][OLED_WIDTH] = {" % (sym, len(gram)))
+                for row in gram:
+                    c.append("    {")
+                    c += c_bytes(row, "        ")
+                    c.append("    },")
+                c.append("};")
+                c.append("static const oled_screen_t scr_%s = {.first_page = %d, "
+                         ".last_page = %d, .rle_size = 0, .data = &%s_bmp[0][0]};"
+                         % (sym, first, last, sym))
+            c.append("")
+
+    c.append("const oled_screen_t *const scr_lang[LANG_COUNT][SCR_COUNT] = {")
+    for lang in langs:
+        c.append("    [LANG_%s] = {" % lang.upper())
+        c += ["        [SCR_%s] = &scr_%s_%s," % (screen[0].upper(), screen[0], lang)
+              for screen in screens]
+        c.append("    },")
+    c += ["};", ""]
+    for name, first, last, items, _ in screens:
+        h.append("  SCR_%s, // 页%d~%d：%s" % (name.upper(), first, last,
+                                            " / ".join(sid for _, _, sid, _ in items)))
+    h += ["  SCR_COUNT", "} scr_id_t;", "",
+          "// 各语言的界面表，按界面ID下标（整张表连续，可作为全部界面的列表遍历）",
+          "extern const oled_screen_t *const scr_lang[LANG_COUNT][SCR_COUNT];",
+          "", "#endif /* SCREENS_H_ */", ""]
+
+    with open(args.out_c, "w", encoding="utf-8") as f:
+        f.write("\n".join(c))
+    with open(args.out_h, "w", encoding="utf-8") as f:
+        f.write("\n".join(h))
+    if args.dump:
+        with open(args.dump + ".raw", "wb") as f:
+            f.write(raw_dump)
+        with open(args.dump + ".rle", "wb") as f:
+            f.write(rle_dump)
+    print("gen_screens: %d screens x %d languages, %d bytes raw, %d bytes RLE (%.1f%%)%s"
+          % (len(screens), len(langs), raw_total, rle_total, 100.0 * rle_total / raw_total,
+             "" if args.rle else ", storing raw"))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Build the per-language UI string tables from assets/strings.txt.
+
+Usage (run by CMake at build time):
+    gen_strings.py --strings assets/strings.txt --out-c strtab.c --out-h strtab.h
+
+Emits one `const char *const` table per language, indexed by the STR_* IDs, so
+a lookup is a single array access (Core/Inc/lang.h). The strings are UTF-8 and
+drawn with the shared glyph tables (F8X16 and font_cjk, see gen_font.py); the
+text itself is the only per-language data.
+"""
+
+import argparse
+
+from ui_strings import load_strings
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--strings", required=True, help="strings.txt")
+    parser.add_argument("--out-c", required=True)
+    parser.add_argument("--out-h", required=True)
+    args = parser.parse_args()
+
+    langs, strings = load_strings(args.strings)
+    name = args.strings.replace("\\", "/").split("/")[-1]
+
+    h = ["/* 由tools/gen_strings.py根据%s生成，请勿手动修改 */" % name,
+         "#ifndef STRTAB_H_", "#define STRTAB_H_", "",
+         "// 界面语言（第一种为默认语言）", "typedef enum {"]
+    h += ["  LANG_%s, // %s" % (lang.upper(), lang) for lang in langs]
+    h += ["  LANG_COUNT", "} lang_t;", "",
+          "// 界面文字ID（各语言的文字见strings.txt）", "typedef enum {"]
+    h += ["  STR_%s, // %s" % (sid, texts[langs[0]] or '""') for sid, texts in strings.items()]
+    h += ["  STR_COUNT", "} str_id_t;", "",
+          "// 各语言的文字表，按文字ID下标",
+          "extern const char *const strtab[LANG_COUNT][STR_COUNT];", "",
+          "#endif /* STRTAB_H_ */", ""]
+
+    c = ["/* 由tools/gen_strings.py根据%s生成，请勿手动修改 */" % name,
+         '#include "strtab.h"', "",
+         "const char *const strtab[LANG_COUNT][STR_COUNT] = {"]
+    total = 0
+    for lang in langs:
+        c.append("    [LANG_%s] = {" % lang.upper())
+        for sid, texts in strings.items():
+            c.append('        [STR_%s] = "%s",' % (sid, texts[lang]))
+            total += len(texts[lang].encode("utf-8")) + 1
+        c.append("    },")
+    c += ["};", ""]
+
+    with open(args.out_c, "w", encoding="utf-8") as f:
+        f.write("\n".join(c))
+    with open(args.out_h, "w", encoding="utf-8") as f:
+        f.write("\n".join(h))
+    print("gen_strings: %d strings x %d languages, %d bytes of text"
+          % (len(strings), len(langs), total))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,76 @@
+/*
+ * Host implementation of Core/Inc/oled_i2c.h. Every transfer goes to the
+ * SSD1306 model; DMA transfers complete only when emu_i2c_run_dma() runs, so
+ * callers see the same "busy until the interrupt" behaviour as on target.
+ */
+#include "emu_i2c.h"
+#include "oled_i2c.h"
+#include "oled_queue.h"
+
+ssd1306_emu_t g_emu;
+
+static struct {
+  bool pending;
+  const uint8_t *buf;
+  uint16_t len;
+  oled_i2c_cb_t cb;
+  void *arg;
+} s_dma;
+static bool s_fail_next = false;
+
+static bool transfer(uint8_t ctrl, const uint8_t *buf, uint16_t len) {
+  if (s_fail_next) {
+    s_fail_next = false;
+    g_emu.count.transactions++;
+    g_emu.count.bus_bytes += 1; // address byte, NACKed
+    return false;
+  }
+  ssd1306_emu_write(&g_emu, ctrl, buf, len);
+  return true;
+}
+
+void emu_i2c_run_dma(void) {
+  while (s_dma.pending) {
+    oled_i2c_cb_t cb = s_dma.cb;
+    void *arg = s_dma.arg;
+    // The DMA buffer starts with the control byte, as on the wire
+    bool ok = transfer(s_dma.buf[0], s_dma.buf + 1, s_dma.len - 1);
+    s_dma.pending = false;
+    if (cb != NULL) {
+      cb(ok, arg); // may start the next transfer, as the completion ISR does
+    }
+    oled_queue_poll(); // the main loop runs fence callbacks
+  }
+}
+
+void emu_i2c_fail_next(void) { s_fail_next = true; }
+
+bool oled_i2c_write(uint8_t ctrl, const uint8_t *buf, uint16_t len) {
+  emu_i2c_run_dma(); // the target blocks until the DMA transfer is done
+  return transfer(ctrl, buf, len);
+}
+
+bool oled_i2c_write_dma(const uint8_t *buf, uint16_t len, oled_i2c_cb_t cb,
+                        void *arg) {
+  if (s_dma.pending) {
+    return false;
+  }
+  s_dma.pending = true;
+  s_dma.buf = buf;
+  s_dma.len = len;
+  s_dma.cb = cb;
+  s_dma.arg = arg;
+  return true;
+}
+
+bool oled_i2c_busy(void) { return s_dma.pending; }
+
+bool oled_i2c_wait_idle(void) {
+  emu_i2c_run_dma();
+  return true;
+}
+
+// Transfers complete synchronously here: no timeouts, no bus faults to back off from
+bool oled_i2c_backoff(void) { return false; }
+
+void oled_i2c_poll(void) {}
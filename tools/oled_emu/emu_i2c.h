@@ -0,0 +1,14 @@
+#ifndef EMU_I2C_H_
+#define EMU_I2C_H_
+
+#include "ssd1306_emu.h"
+
+// The panel behind the emulated oled_i2c.c
+extern ssd1306_emu_t g_emu;
+
+// Complete every queued DMA transfer (what the I2C/DMA interrupts do on target)
+void emu_i2c_run_dma(void);
+// Make the next transfer fail like a NACK/bus error
+void emu_i2c_fail_next(void);
+
+#endif /* EMU_I2C_H_ */
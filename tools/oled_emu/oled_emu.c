@@ -0,0 +1,446 @@
+/*
+ * Runs the firmware's display code (Core/Src/oled.c and friends) against the
+ * SSD1306 model and reports the I2C traffic of each step.
+ *
+ *   cmake -S tools/oled_emu -B build-emu && cmake --build build-emu
+ *   build-emu/oled_emu                       # traffic table only
+ *   build-emu/oled_emu --out snapshots       # also write NN_step.pbm/.pgm
+ *   build-emu/oled_emu --check snapshots     # compare with saved PBMs, exit 1 on change
+ *
+ * Counters are per step: transactions, bytes on the bus (address and control
+ * byte included), command and data payload, GDDRAM bytes that really changed,
+ * and the bus time this costs at --khz (default 400).
+ */
+#include "anim.h"
+#include "emu_i2c.h"
+#include "lang.h"
+#include "marquee.h"
+#include "oled.h"
+#include "oled_queue.h"
+#include "progress.h"
+#include "swtimer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *s_out_dir = NULL;
+static const char *s_check_dir = NULL;
+static uint32_t s_khz = 400;
+static int s_step = 0;
+static int s_failures = 0;
+static uint32_t s_tick_ms = 0;
+
+// SysTick: HAL_GetTick() and the software timers advance together
+uint32_t HAL_GetTick(void) { return s_tick_ms; }
+
+static void systick(void) {
+  s_tick_ms++;
+  swtimer_tick();
+}
+
+// Send everything drawn so far, the way ui_poll() does once per loop
+static void refresh(void) {
+  OLED_Refresh();
+  emu_i2c_run_dma();
+}
+
+static void step(const char *name, void (*fn)(void)) {
+  char path[512];
+  memset(&g_emu.count, 0, sizeof(g_emu.count));
+  fn();
+  emu_i2c_run_dma();
+
+  const emu_counters_t *c = &g_emu.count;
+  printf("%2d %-22s %6u %7u %6u %7u %7u %8.2f", s_step, name, c->transactions,
+         c->bus_bytes, c->cmd_bytes, c->data_bytes, c->ram_changed,
+         ssd1306_emu_bus_us(c, s_khz) / 1000.0);
+  if (c->unknown_cmds || c->scroll_writes) {
+    printf("  unknown_cmds=%u scroll_writes=%u", c->unknown_cmds,
+           c->scroll_writes);
+  }
+
+  if (s_out_dir != NULL) {
+    snprintf(path, sizeof(path), "%s/%02d_%s.pbm", s_out_dir, s_step, name);
+    if (ssd1306_emu_write_pbm(&g_emu, path) != 0) {
+      perror(path);
+      exit(2);
+    }
+    snprintf(path, sizeof(path), "%s/%02d_%s.pgm", s_out_dir, s_step, name);
+    ssd1306_emu_write_pgm(&g_emu, path);
+  }
+  if (s_check_dir != NULL) {
+    snprintf(path, sizeof(path), "%s/%02d_%s.pbm", s_check_dir, s_step, name);
+    long diff = ssd1306_emu_compare_pbm(&g_emu, path);
+    if (diff != 0) {
+      if (diff < 0) {
+        printf("  MISSING %s", path);
+      } else {
+        printf("  DIFF %ld px", diff);
+      }
+      s_failures++;
+    }
+  }
+  printf("\n");
+  s_step++;
+}
+
+static void do_init(void) {
+  OLED_Init();
+  OLED_IntensityControl(0xFF);
+  refresh();
+}
+
+static void do_clock(void) {
+  OLED_ShowString(0, 0, "2025-09-13 18:45", 16, 0);
+  refresh();
+}
+
+static void do_main(void) {
+  OLED_ShowScreen(SCREEN(SCR_MAIN));
+  refresh();
+}
+
+static void do_minute_tick(void) {
+  OLED_ShowChar(15 * 8, 0, '6', 16, 0); // 18:45 -> 18:46
+  refresh();
+}
+
+static void do_nothing_changed(void) {
+  OLED_ShowScreen(SCREEN(SCR_MAIN));
+  OLED_ShowString(0, 0, "2025-09-13 18:46", 16, 0);
+  refresh();
+}
+
+static void do_enroll_select(void) {
+  OLED_ShowScreen(SCREEN(SCR_ENROLL_SELECT));
+  OLED_DrawText(64, 32, "序号： 9", OLED_ALIGN_CENTER, OLED_COPY);
+  refresh();
+}
+
+// Same line as main.c show_id_line(): fixed-width number, only digits change
+static void do_id_increment(void) {
+  OLED_DrawText(64, 32, "序号：10", OLED_ALIGN_CENTER, OLED_COPY);
+  refresh();
+}
+
+// Unaligned y, right/centre alignment and clipping at both screen edges
+static void do_text_layout(void) {
+  OLED_ClearRows(2, 7);
+  OLED_DrawText(-12, 19, "库中第12个", OLED_ALIGN_LEFT, OLED_COPY);
+  OLED_DrawText(OLED_WIDTH - 1, 19, "18:45", OLED_ALIGN_RIGHT, OLED_SET);
+  OLED_DrawText(64, 37, "Alexandra Konstantinopoulou", OLED_ALIGN_CENTER, OLED_COPY);
+  refresh();
+}
+
+// Drawing and refreshing again before the first frame is on the panel: drawing
+// does not wait for the bus, the second frame is held back until the first has
+// been sent and goes out on the next main-loop pass
+static void do_queued_while_busy(void) {
+  OLED_ShowScreen(SCREEN(SCR_DELETE_SELECT));
+  OLED_Refresh();
+  OLED_DrawText(64, 32, "库中第 3个", OLED_ALIGN_CENTER, OLED_COPY);
+  OLED_Refresh(); // deferred: frame 1 still streaming
+  OLED_IntensityControl(0xFF);
+  refresh();
+  refresh();
+}
+
+static void do_connecting(void) {
+  OLED_ShowScreen(SCREEN(SCR_CONNECTING_ENROLL));
+  refresh();
+}
+
+static void do_face_state(void) {
+  OLED_ShowScreen(SCREEN(SCR_FACE_NORMAL_ENROLL));
+  refresh();
+}
+
+static void do_enroll_success(void) {
+  OLED_ShowScreen(SCREEN(SCR_ENROLL_SUCCESS));
+  refresh();
+}
+
+static void do_full_refresh(void) {
+  OLED_Invalidate();
+  refresh();
+}
+
+// Per-byte page-mode pass followed by the single-window pass (Debug boot)
+static void do_bench_full_refresh(void) { OLED_BenchFullRefresh(); }
+
+static void do_refresh_error(void) {
+  OLED_ShowScreen(SCREEN(SCR_VERIFY_FAILED));
+  emu_i2c_fail_next();
+  refresh(); // fails; the next refresh resends the whole screen
+  refresh();
+}
+
+static void do_dim(void) { OLED_IntensityControl(0x10); }
+
+static void do_off(void) { OLED_Display_Off(); }
+
+static void do_on(void) {
+  OLED_Display_On();
+  OLED_IntensityControl(0xFF);
+}
+
+static void do_scroll(void) {
+  OLED_Some_HorizontalShift(0x27, 2, 3);
+  emu_i2c_run_dma(); // commands are queued like drawing; let the panel see them
+  ssd1306_emu_scroll_step(&g_emu, 32);
+}
+
+// Drawing while scrolling: OLED_Refresh stops the scroll before writing GDDRAM
+static void do_draw_while_scrolling(void) {
+  OLED_ShowScreen(SCREEN(SCR_FACE_NORMAL_ENROLL));
+  refresh();
+}
+
+static void do_vh_scroll(void) {
+  OLED_VerticalAndHorizontalShift(0x29);
+  emu_i2c_run_dma();
+  ssd1306_emu_scroll_step(&g_emu, 8);
+}
+
+static void do_scroll_stop(void) {
+  OLED_ScrollStop();
+  refresh();
+}
+
+// One main-loop pass as in ui_poll(), then let time pass on the panel and SysTick
+static void ui_loop(uint32_t ms) {
+  refresh();
+  marquee_poll();
+  refresh();
+  marquee_poll();
+  emu_i2c_run_dma();
+  ssd1306_emu_scroll_step(&g_emu, ms / MARQUEE_STEP_MS);
+  while (ms--) {
+    systick();
+  }
+}
+
+static void do_marquee_start(void) {
+  OLED_ShowScreen(SCREEN(SCR_VERIFY_SUCCESS));
+  OLED_ShowNum(72, 4, 7, 2, 16, 0);
+  marquee_start(6, "Alexandra Konstantinopoulou-Ng", MARQUEE_TEXT_MAX);
+  ui_loop(MARQUEE_LAP_MS / 4);
+}
+
+static void do_marquee_lap(void) { ui_loop(MARQUEE_LAP_MS * 3 / 4); }
+
+static void do_marquee_next(void) { ui_loop(MARQUEE_LAP_MS / 4); }
+
+// 12x12 ring, page-packed like OLED_GRAM (two rows of 12 bytes)
+static const uint8_t s_icon[2][12] = {
+    {0xF0, 0x0C, 0x02, 0x02, 0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x0C, 0xF0},
+    {0x00, 0x03, 0x04, 0x04, 0x08, 0x08, 0x08, 0x08, 0x04, 0x04, 0x03, 0x00},
+};
+
+static void do_gfx(void) {
+  OLED_ClearRows(2, 7);
+  OLED_Rect(8, 18, 119, 45, OLED_SET);
+  OLED_FillRect(12, 22, 40, 41, OLED_SET);
+  OLED_FillRect(30, 20, 60, 43, OLED_XOR);
+  OLED_Blit(70, 21, 12, 12, &s_icon[0][0], OLED_SET);
+  OLED_Blit(-4, 50, 12, 12, &s_icon[0][0], OLED_COPY);
+  OLED_Blit(122, 58, 12, 12, &s_icon[0][0], OLED_XOR);
+  refresh();
+}
+
+static void do_progress_start(void) {
+  OLED_ShowScreen(SCREEN(SCR_CONNECTING_VERIFY));
+  progress_start(7, HAL_GetTick() + 10000, 10000);
+  refresh();
+}
+
+// One second of the countdown: each pass redraws only the freed columns
+static void do_progress_second(void) {
+  for (uint32_t ms = 0; ms < 1000; ms++) {
+    systick();
+    progress_poll();
+    refresh();
+  }
+}
+
+static void do_progress_stop(void) {
+  progress_stop();
+  refresh();
+}
+
+// Enroll/delete ID line as in main.c show_big_id_line(): 2x digits on pages 4-7,
+// prefix bottom-aligned on pages 6-7
+static void do_big_id(void) {
+  OLED_ShowScreen(SCREEN(SCR_DELETE_SELECT));
+  OLED_DrawText(16, 48, "库中第", OLED_ALIGN_LEFT, OLED_COPY);
+  OLED_DrawText2X(64, 32, " 9", OLED_ALIGN_LEFT, OLED_COPY);
+  OLED_DrawText(96, 48, "个", OLED_ALIGN_LEFT, OLED_COPY);
+  refresh();
+}
+
+static void do_big_id_increment(void) {
+  OLED_DrawText2X(64, 32, "10", OLED_ALIGN_LEFT, OLED_COPY);
+  refresh();
+}
+
+// Idle clock as in main.c show_big_clock(): HH:MM:SS at 2x on pages 3-6
+static void do_big_clock(void) {
+  OLED_ClearRows(2, 7);
+  OLED_DrawText2X(0, 24, "18:46:09", OLED_ALIGN_LEFT, OLED_COPY);
+  refresh();
+}
+
+// One second later: only the last digit is redrawn
+static void do_big_clock_second(void) {
+  OLED_DrawText2X(7 * 16, 24, "0", OLED_ALIGN_LEFT, OLED_COPY);
+  refresh();
+}
+
+// Main loop as in ui_poll() for ms milliseconds of SysTick: anim_poll() draws
+// the latest due frame, each pass commits what it drew
+static void anim_loop(uint32_t ms) {
+  while (ms--) {
+    systick();
+    anim_poll();
+    refresh();
+  }
+}
+
+// Screen change with a wipe: only the left sixth reaches the panel at first
+static void do_wipe_first(void) {
+  OLED_ShowScreen(SCREEN(SCR_ENROLL_SUCCESS));
+  anim_wipe();
+  refresh();
+}
+
+static void do_wipe_done(void) { anim_loop(ANIM_WIPE_FRAMES * ANIM_TICK_MS); }
+
+// Result line as in main.c ui_enter(UI_RESULT): inverted at once, then blinks
+static void do_blink_on(void) {
+  anim_blink(0, 16, OLED_WIDTH - 1, 31, 3);
+  refresh();
+}
+
+static void do_blink_done(void) {
+  anim_loop(3 * 2 * ANIM_BLINK_FRAMES * ANIM_TICK_MS);
+}
+
+// Spinner right of "设备正在连接" while waiting for the module, 10 steps
+static void do_spinner(void) {
+  OLED_ShowScreen(SCREEN(SCR_CONNECTING_VERIFY));
+  anim_spinner(116, 20);
+  refresh();
+  anim_loop(10 * ANIM_SPINNER_FRAMES * ANIM_TICK_MS);
+}
+
+static void do_spinner_stop(void) {
+  anim_stop();
+  refresh();
+}
+
+// English tables (lang.h): the same layouts pre-rendered from strings.txt
+static void do_lang_en_main(void) {
+  lang_set(LANG_EN);
+  OLED_ShowScreen(SCREEN(SCR_MAIN));
+  refresh();
+}
+
+// Delete select as in main.c show_big_id_line() with the English prefix
+static void do_lang_en_select(void) {
+  const char *prefix = STR(STR_USER_ID_PREFIX);
+  int16_t x = (int16_t)(OLED_WIDTH - OLED_TextWidth(prefix) - OLED_TextWidth(" 9") * 2) / 2;
+  OLED_ShowScreen(SCREEN(SCR_DELETE_SELECT));
+  x += OLED_DrawText(x, 48, prefix, OLED_ALIGN_LEFT, OLED_COPY);
+  OLED_DrawText2X(x, 32, " 9", OLED_ALIGN_LEFT, OLED_COPY);
+  refresh();
+}
+
+static void do_lang_en_result(void) {
+  OLED_ShowScreen(SCREEN(SCR_CONNECT_FAILED));
+  refresh();
+  lang_set(LANG_ZH);
+}
+
+static void do_marquee_stop(void) {
+  marquee_stop();
+  OLED_ShowScreen(SCREEN(SCR_MAIN));
+  refresh();
+}
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+      s_out_dir = argv[++i];
+    } else if (!strcmp(argv[i], "--check") && i + 1 < argc) {
+      s_check_dir = argv[++i];
+    } else if (!strcmp(argv[i], "--khz") && i + 1 < argc) {
+      s_khz = (uint32_t)atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "usage: %s [--out DIR] [--check DIR] [--khz N]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  ssd1306_emu_reset(&g_emu);
+  swtimer_init();
+  printf("%2s %-22s %6s %7s %6s %7s %7s %8s\n", "#", "step", "xfers", "bytes",
+         "cmd", "data", "changed", "bus_ms");
+  step("init", do_init);
+  step("clock", do_clock);
+  step("main", do_main);
+  step("minute_tick", do_minute_tick);
+  step("nothing_changed", do_nothing_changed);
+  step("enroll_select", do_enroll_select);
+  step("id_increment", do_id_increment);
+  step("text_layout", do_text_layout);
+  step("queued_while_busy", do_queued_while_busy);
+  step("connecting", do_connecting);
+  step("face_state", do_face_state);
+  step("enroll_success", do_enroll_success);
+  step("full_refresh", do_full_refresh);
+  step("bench_full_refresh", do_bench_full_refresh);
+  step("refresh_error", do_refresh_error);
+  step("dim", do_dim);
+  step("off", do_off);
+  step("on", do_on);
+  step("scroll", do_scroll);
+  step("draw_while_scrolling", do_draw_while_scrolling);
+  step("vh_scroll", do_vh_scroll);
+  step("vh_scroll_stop", do_scroll_stop);
+  step("marquee_start", do_marquee_start);
+  step("marquee_lap", do_marquee_lap);
+  step("marquee_next", do_marquee_next);
+  step("marquee_stop", do_marquee_stop);
+  step("big_id", do_big_id);
+  step("big_id_increment", do_big_id_increment);
+  step("big_clock", do_big_clock);
+  step("big_clock_second", do_big_clock_second);
+  step("gfx", do_gfx);
+  step("progress_start", do_progress_start);
+  step("progress_second", do_progress_second);
+  step("progress_stop", do_progress_stop);
+  step("wipe_first", do_wipe_first);
+  step("wipe_done", do_wipe_done);
+  step("blink_on", do_blink_on);
+  step("blink_done", do_blink_done);
+  step("spinner", do_spinner);
+  step("spinner_stop", do_spinner_stop);
+  step("lang_en_main", do_lang_en_main);
+  step("lang_en_select", do_lang_en_select);
+  step("lang_en_result", do_lang_en_result);
+
+  printf("queue: ops_max=%u bytes_max=%u full=%u errors=%u drains=%u\n",
+         oled_queue_stats.ops_max, oled_queue_stats.bytes_max,
+         oled_queue_stats.full_count, oled_queue_stats.error_count,
+         oled_queue_stats.drain_count);
+  printf("frames: committed=%u deferred=%u\n", oled_stats.frame_count,
+         oled_stats.frame_deferred);
+  printf("anim: drawn=%u skipped=%u over_budget=%u draw_us_max=%u\n",
+         anim_stats.drawn, anim_stats.skipped, anim_stats.over_budget,
+         anim_stats.draw_us_max);
+  if (s_check_dir != NULL) {
+    printf("%s: %d step(s) differ from %s\n", s_failures ? "FAIL" : "OK",
+           s_failures, s_check_dir);
+  }
+  return s_failures ? 1 : 0;
+}
@@ -0,0 +1,22 @@
+/* Host stand-in for Core/Inc/dwt.h: a 72 MHz cycle counter from CLOCK_MONOTONIC */
+#ifndef DWT_H_
+#define DWT_H_
+
+#include <stdint.h>
+#include <time.h>
+
+#define DWT_CYCLES_PER_US 72U
+
+static inline void dwt_init(void) {}
+
+static inline uint32_t dwt_cycles(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 72000000ULL + ts.tv_nsec * 72ULL / 1000ULL);
+}
+
+static inline uint32_t dwt_cycles_to_us(uint32_t cycles) {
+  return cycles / DWT_CYCLES_PER_US;
+}
+
+#endif /* DWT_H_ */
@@ -0,0 +1,23 @@
+/* Host stand-in for the HAL header: just what the Core/ sources built here use */
+#ifndef STM32F1XX_HAL_H_EMU_
+#define STM32F1XX_HAL_H_EMU_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+  int unused;
+} I2C_HandleTypeDef;
+
+#define __weak __attribute__((weak))
+
+// Millisecond tick, advanced by the scenario loops in oled_emu.c
+uint32_t HAL_GetTick(void);
+
+// Single-threaded host: interrupt masking is a no-op
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+
+#endif /* STM32F1XX_HAL_H_EMU_ */
@@ -0,0 +1,265 @@
+#include "ssd1306_emu.h"
+#include <stdio.h>
+#include <string.h>
+
+// Total length (command byte included) of the multi-byte commands
+static uint8_t cmd_length(uint8_t c) {
+  switch (c) {
+  case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+  case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+    return 2;
+  case 0x21: case 0x22: case 0xA3:
+    return 3;
+  case 0x29: case 0x2A:
+    return 6;
+  case 0x26: case 0x27:
+    return 7;
+  default:
+    return 1;
+  }
+}
+
+static bool cmd_known(uint8_t c) {
+  return c <= 0x1F || c == 0x2E || c == 0x2F || (c >= 0x40 && c <= 0x7F) ||
+         c == 0xA0 || c == 0xA1 || (c >= 0xA4 && c <= 0xA7) || c == 0xAE ||
+         c == 0xAF || (c >= 0xB0 && c <= 0xB7) || c == 0xC0 || c == 0xC8 ||
+         c == 0xE3 || cmd_length(c) > 1;
+}
+
+void ssd1306_emu_reset(ssd1306_emu_t *emu) {
+  memset(emu, 0, sizeof(*emu));
+  // Power-on defaults from the datasheet; GDDRAM content is really undefined
+  memset(emu->ram, 0xA5, sizeof(emu->ram));
+  emu->mode = 2;
+  emu->col_end = EMU_WIDTH - 1;
+  emu->page_end = EMU_PAGES - 1;
+  emu->contrast = 0x7F;
+}
+
+static void run_cmd(ssd1306_emu_t *emu) {
+  const uint8_t *a = emu->cmd;
+  uint8_t c = a[0];
+
+  if (c <= 0x0F) {
+    emu->col = (emu->col & 0xF0) | c;
+  } else if (c <= 0x1F) {
+    emu->col = (uint8_t)(((c & 0x0F) << 4) | (emu->col & 0x0F));
+  } else if (c >= 0x40 && c <= 0x7F) {
+    emu->start_line = c & 0x3F;
+  } else if (c >= 0xB0 && c <= 0xB7) {
+    emu->page = c & 0x07;
+  } else {
+    switch (c) {
+    case 0x20: emu->mode = a[1] & 0x03; break;
+    case 0x21:
+      emu->col_start = emu->col = a[1] & 0x7F;
+      emu->col_end = a[2] & 0x7F;
+      break;
+    case 0x22:
+      emu->page_start = emu->page = a[1] & 0x07;
+      emu->page_end = a[2] & 0x07;
+      break;
+    case 0x26: case 0x27:
+      emu->scroll_cmd = c;
+      emu->scroll_start = a[2] & 0x07;
+      emu->scroll_end = a[4] & 0x07;
+      emu->scroll_vertical = 0;
+      break;
+    case 0x29: case 0x2A:
+      emu->scroll_cmd = c;
+      emu->scroll_start = a[2] & 0x07;
+      emu->scroll_end = a[4] & 0x07;
+      emu->scroll_vertical = a[5] & 0x3F;
+      break;
+    case 0x2E: emu->scroll_active = false; break;
+    case 0x2F: emu->scroll_active = emu->scroll_cmd != 0; break;
+    case 0x81: emu->contrast = a[1]; break;
+    case 0x8D: emu->charge_pump = (a[1] & 0x04) != 0; break;
+    case 0xA0: case 0xA1: emu->seg_remap = c & 1; break;
+    case 0xA4: case 0xA5: emu->entire_on = c & 1; break;
+    case 0xA6: case 0xA7: emu->invert = c & 1; break;
+    case 0xAE: case 0xAF: emu->display_on = c & 1; break;
+    case 0xC0: case 0xC8: emu->com_remap = (c & 0x08) != 0; break;
+    case 0xD3: emu->offset = a[1] & 0x3F; break;
+    default: break; // timing/hardware configuration without visible effect
+    }
+  }
+}
+
+static void write_cmd(ssd1306_emu_t *emu, uint8_t b) {
+  if (emu->cmd_len == 0) {
+    if (!cmd_known(b)) {
+      emu->count.unknown_cmds++;
+      return;
+    }
+    emu->cmd_need = cmd_length(b);
+  }
+  emu->cmd[emu->cmd_len++] = b;
+  if (emu->cmd_len == emu->cmd_need) {
+    run_cmd(emu);
+    emu->cmd_len = 0;
+  }
+}
+
+static void write_data(ssd1306_emu_t *emu, uint8_t b) {
+  uint8_t *cell = &emu->ram[emu->page][emu->col];
+  if (*cell != b) {
+    emu->count.ram_changed++;
+  }
+  *cell = b;
+  if (emu->scroll_active) {
+    emu->count.scroll_writes++;
+  }
+
+  switch (emu->mode) {
+  case 0: // horizontal: column first, then next page inside the window
+    if (emu->col >= emu->col_end) {
+      emu->col = emu->col_start;
+      emu->page = (emu->page >= emu->page_end) ? emu->page_start : emu->page + 1;
+    } else {
+      emu->col++;
+    }
+    break;
+  case 1: // vertical: page first, then next column
+    if (emu->page >= emu->page_end) {
+      emu->page = emu->page_start;
+      emu->col = (emu->col >= emu->col_end) ? emu->col_start : emu->col + 1;
+    } else {
+      emu->page++;
+    }
+    break;
+  default: // page: column wraps inside the page
+    emu->col = (emu->col + 1) & 0x7F;
+    break;
+  }
+}
+
+void ssd1306_emu_write(ssd1306_emu_t *emu, uint8_t ctrl, const uint8_t *buf,
+                       size_t len) {
+  bool data = (ctrl & 0x40) != 0;
+  emu->count.transactions++;
+  emu->count.bus_bytes += 2 + (uint32_t)len;
+  if (data) {
+    emu->count.data_bytes += (uint32_t)len;
+  } else {
+    emu->count.cmd_bytes += (uint32_t)len;
+  }
+  for (size_t i = 0; i < len; i++) {
+    if (data) {
+      write_data(emu, buf[i]);
+    } else {
+      write_cmd(emu, buf[i]);
+    }
+  }
+}
+
+// One scroll step: the scrolled pages rotate by one column in GDDRAM, which is
+// why the firmware has to rewrite them after 0x2E
+void ssd1306_emu_scroll_step(ssd1306_emu_t *emu, unsigned steps) {
+  if (!emu->scroll_active) {
+    return;
+  }
+  bool right = emu->scroll_cmd == 0x26 || emu->scroll_cmd == 0x29;
+  while (steps--) {
+    for (uint8_t p = emu->scroll_start; p <= emu->scroll_end && p < EMU_PAGES; p++) {
+      uint8_t *row = emu->ram[p];
+      if (right) {
+        uint8_t last = row[EMU_WIDTH - 1];
+        memmove(&row[1], &row[0], EMU_WIDTH - 1);
+        row[0] = last;
+      } else {
+        uint8_t first = row[0];
+        memmove(&row[0], &row[1], EMU_WIDTH - 1);
+        row[EMU_WIDTH - 1] = first;
+      }
+    }
+    emu->start_line = (emu->start_line + emu->scroll_vertical) & 0x3F;
+  }
+}
+
+// Visible pixel at (x, y) as seen on the module; the firmware's 0xA1/0xC8
+// setup is the upright orientation
+int ssd1306_emu_pixel(const ssd1306_emu_t *emu, int x, int y) {
+  if (!emu->display_on || !emu->charge_pump) {
+    return 0;
+  }
+  if (emu->entire_on) {
+    return 1;
+  }
+  int col = emu->seg_remap ? x : EMU_WIDTH - 1 - x;
+  int row = emu->com_remap ? y : EMU_HEIGHT - 1 - y;
+  row = (row + emu->start_line + emu->offset) & 0x3F;
+  int bit = (emu->ram[row >> 3][col] >> (row & 7)) & 1;
+  return bit ^ emu->invert;
+}
+
+// Bus time: 9 bit times per byte plus START/STOP per transaction
+uint32_t ssd1306_emu_bus_us(const emu_counters_t *count, uint32_t khz) {
+  uint64_t bits = (uint64_t)count->bus_bytes * 9 + (uint64_t)count->transactions * 2;
+  return (uint32_t)(bits * 1000 / khz);
+}
+
+// PBM (P4): lit pixels are written as white, dark pixels as black
+int ssd1306_emu_write_pbm(const ssd1306_emu_t *emu, const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (f == NULL) {
+    return -1;
+  }
+  fprintf(f, "P4\n%d %d\n", EMU_WIDTH, EMU_HEIGHT);
+  for (int y = 0; y < EMU_HEIGHT; y++) {
+    for (int x = 0; x < EMU_WIDTH; x += 8) {
+      uint8_t b = 0;
+      for (int i = 0; i < 8; i++) {
+        b |= (uint8_t)(!ssd1306_emu_pixel(emu, x + i, y) << (7 - i));
+      }
+      fputc(b, f);
+    }
+  }
+  return fclose(f);
+}
+
+// PGM (P5): lit pixels scaled by the contrast setting
+int ssd1306_emu_write_pgm(const ssd1306_emu_t *emu, const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (f == NULL) {
+    return -1;
+  }
+  uint8_t lit = (uint8_t)(40 + emu->contrast * 215 / 255);
+  fprintf(f, "P5\n%d %d\n255\n", EMU_WIDTH, EMU_HEIGHT);
+  for (int y = 0; y < EMU_HEIGHT; y++) {
+    for (int x = 0; x < EMU_WIDTH; x++) {
+      fputc(ssd1306_emu_pixel(emu, x, y) ? lit : 0, f);
+    }
+  }
+  return fclose(f);
+}
+
+// Number of pixels that differ from a golden P4 file, -1 if it cannot be read
+long ssd1306_emu_compare_pbm(const ssd1306_emu_t *emu, const char *path) {
+  FILE *f = fopen(path, "rb");
+  int w, h;
+  long diff = 0;
+  if (f == NULL) {
+    return -1;
+  }
+  if (fscanf(f, "P4 %d %d", &w, &h) != 2 || w != EMU_WIDTH || h != EMU_HEIGHT ||
+      fgetc(f) == EOF) {
+    fclose(f);
+    return -1;
+  }
+  for (int y = 0; y < EMU_HEIGHT; y++) {
+    for (int x = 0; x < EMU_WIDTH; x += 8) {
+      int b = fgetc(f);
+      if (b == EOF) {
+        fclose(f);
+        return -1;
+      }
+      for (int i = 0; i < 8; i++) {
+        int dark = (b >> (7 - i)) & 1;
+        diff += dark == ssd1306_emu_pixel(emu, x + i, y);
+      }
+    }
+  }
+  fclose(f);
+  return diff;
+}
@@ -0,0 +1,63 @@
+#ifndef SSD1306_EMU_H_
+#define SSD1306_EMU_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define EMU_WIDTH 128
+#define EMU_HEIGHT 64
+#define EMU_PAGES 8
+
+// I2C traffic; one oled_i2c_write / oled_i2c_write_dma call is one transaction
+typedef struct {
+  uint32_t transactions;  // START ... STOP sequences
+  uint32_t bus_bytes;     // address + control byte + payload
+  uint32_t cmd_bytes;     // command payload bytes
+  uint32_t data_bytes;    // GDDRAM payload bytes
+  uint32_t ram_changed;   // GDDRAM bytes whose value actually changed
+  uint32_t unknown_cmds;  // command bytes the controller would ignore
+  uint32_t scroll_writes; // GDDRAM writes while scrolling (undefined per datasheet)
+} emu_counters_t;
+
+// SSD1306 controller model
+typedef struct {
+  uint8_t ram[EMU_PAGES][EMU_WIDTH]; // GDDRAM, one byte = 8 vertical pixels, LSB on top
+
+  uint8_t mode;                 // addressing mode: 0 horizontal, 1 vertical, 2 page
+  uint8_t col, page;            // write pointer
+  uint8_t col_start, col_end;   // window for horizontal/vertical mode (0x21)
+  uint8_t page_start, page_end; // window for horizontal/vertical mode (0x22)
+
+  uint8_t contrast;
+  bool display_on;
+  bool charge_pump;
+  bool invert;
+  bool entire_on;
+  bool seg_remap; // 0xA1
+  bool com_remap; // 0xC8
+  uint8_t start_line;
+  uint8_t offset;
+
+  bool scroll_active;
+  uint8_t scroll_cmd; // 0x26/0x27/0x29/0x2A
+  uint8_t scroll_start, scroll_end, scroll_vertical;
+
+  uint8_t cmd[8];   // multi-byte command being received
+  uint8_t cmd_len;  // bytes received so far
+  uint8_t cmd_need; // total length of that command
+
+  emu_counters_t count;
+} ssd1306_emu_t;
+
+void ssd1306_emu_reset(ssd1306_emu_t *emu);
+void ssd1306_emu_write(ssd1306_emu_t *emu, uint8_t ctrl, const uint8_t *buf,
+                       size_t len);
+void ssd1306_emu_scroll_step(ssd1306_emu_t *emu, unsigned steps);
+int ssd1306_emu_pixel(const ssd1306_emu_t *emu, int x, int y);
+uint32_t ssd1306_emu_bus_us(const emu_counters_t *count, uint32_t khz);
+int ssd1306_emu_write_pbm(const ssd1306_emu_t *emu, const char *path);
+int ssd1306_emu_write_pgm(const ssd1306_emu_t *emu, const char *path);
+long ssd1306_emu_compare_pbm(const ssd1306_emu_t *emu, const char *path);
+
+#endif /* SSD1306_EMU_H_ */
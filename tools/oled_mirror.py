@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Live view of the gate's OLED, rebuilt from the display mirror stream.
+
+Build the firmware with -DOLED_MIRROR_ENABLE=ON; every span written to the
+panel is then sent over USART3 (see Core/Inc/oled_mirror.h), interleaved with
+the trace frames that tools/trace_decode.py reads.
+
+Usage:
+    oled_mirror.py /dev/ttyUSB0                 # live view in the terminal (460800 8N1)
+    oled_mirror.py capture.bin --pbm last.pbm   # replay a capture, save the final frame
+
+Frame: 'O' 'M' | seq | page | x0 | len | len bytes of GDDRAM data | BCC
+Each data byte is one column of 8 pixels in the page, LSB on top (panel layout).
+BCC is the XOR of every byte from seq up to the last data byte. Only changed
+spans are sent, so the picture is complete once the firmware has redrawn the
+screen after the viewer started (it sends the whole screen after OLED_Init).
+"""
+
+import argparse
+import select
+import sys
+import time
+
+from trace_decode import open_input
+
+SYNC = b"OM"
+WIDTH = 128
+PAGES = 8
+HEIGHT = PAGES * 8
+
+# Two pixel rows per terminal line: (top, bottom) -> character
+CELLS = {(False, False): " ", (True, False): "▀",
+         (False, True): "▄", (True, True): "█"}
+
+
+def packets(stream, idle=None):
+    """Yield (seq, page, x0, data) for every frame with a valid BCC.
+
+    With idle set, also yield None whenever no byte arrives for that many seconds.
+    """
+    buf = bytearray()
+    while True:
+        if idle is not None and not select.select([stream], [], [], idle)[0]:
+            yield None
+            continue
+        chunk = stream.read(4096)
+        if not chunk:
+            return
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                del buf[:-1]
+                break
+            del buf[:start]
+            if len(buf) < 6:
+                break
+            seq, page, x0, length = buf[2], buf[3], buf[4], buf[5]
+            if page >= PAGES or length == 0 or x0 + length > WIDTH:
+                del buf[:1]
+                continue
+            size = 6 + length + 1
+            if len(buf) < size:
+                break
+            bcc = 0
+            for b in buf[2:size - 1]:
+                bcc ^= b
+            if bcc != buf[size - 1]:
+                del buf[:1]  # trace frame or false sync, rescan from the next byte
+                continue
+            yield seq, page, x0, bytes(buf[6:size - 1])
+            del buf[:size]
+
+
+def pixel(gram, x, y):
+    return bool(gram[y // 8][x] >> (y % 8) & 1)
+
+
+def render(gram):
+    lines = []
+    for y in range(0, HEIGHT, 2):
+        lines.append("".join(CELLS[pixel(gram, x, y), pixel(gram, x, y + 1)]
+                             for x in range(WIDTH)))
+    return lines
+
+
+def write_pbm(path, gram):
+    """Lit pixels white, as in the oled_emu snapshots (PBM 1 is black)."""
+    rows = bytearray()
+    for y in range(HEIGHT):
+        for x0 in range(0, WIDTH, 8):
+            byte = 0
+            for x in range(x0, x0 + 8):
+                byte = byte << 1 | (not pixel(gram, x, y))
+            rows.append(byte)
+    with open(path, "wb") as f:
+        f.write(b"P4\n%d %d\n" % (WIDTH, HEIGHT) + rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="serial device, capture file or '-'")
+    parser.add_argument("--baud", type=int, default=460800)
+    parser.add_argument("--fps", type=float, default=25,
+                        help="maximum terminal redraw rate (default 25)")
+    parser.add_argument("--pbm", help="write the final frame to this PBM file on exit")
+    args = parser.parse_args()
+
+    stream = open_input(args.input, args.baud)
+    live = sys.stdout.isatty()
+    gram = [bytearray(WIDTH) for _ in range(PAGES)]
+    expected = None
+    count = lost = data_bytes = 0
+    last_draw = 0.0
+    dirty = False
+
+    def draw():
+        out = ["\x1b[H"]
+        out += [line + "\n" for line in render(gram)]
+        out.append("seq=%-3d packets=%d data_bytes=%d lost=%d\x1b[K\n"
+                   % (expected - 1 & 0xFF, count, data_bytes, lost))
+        sys.stdout.write("".join(out))
+        sys.stdout.flush()
+
+    if live:
+        sys.stdout.write("\x1b[2J")
+    try:
+        for packet in packets(stream, 1.0 / args.fps if live else None):
+            if packet is None:
+                if dirty:
+                    draw()  # the stream went quiet: show the latest frame
+                    dirty = False
+                continue
+            seq, page, x0, data = packet
+            if expected is not None and seq != expected:
+                lost += (seq - expected) & 0xFF
+            expected = (seq + 1) & 0xFF
+            gram[page][x0:x0 + len(data)] = data
+            count += 1
+            data_bytes += len(data)
+            dirty = True
+            now = time.monotonic()
+            if live and now - last_draw >= 1.0 / args.fps:
+                draw()
+                last_draw = now
+                dirty = False
+    except KeyboardInterrupt:
+        pass
+
+    if live and dirty:
+        draw()
+    if not live:
+        print("packets=%d data_bytes=%d lost=%d" % (count, data_bytes, lost))
+    if args.pbm:
+        write_pbm(args.pbm, gram)
+
+
+if __name__ == "__main__":
+    main()
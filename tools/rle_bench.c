@@ -0,0 +1,94 @@
+/*
+ * Host benchmark for the screen RLE decoder (Core/Src/rle.c).
+ *
+ *   python3 tools/gen_screens.py --font Core/Src/oledfont.c \
+ *       --bdf assets/fonts/ui16.bdf --layout assets/screens.txt \
+ *       --strings assets/strings.txt --out-c /tmp/screens.c --out-h /tmp/screens.h --rle --dump /tmp/scr
+ *   cc -O2 -ICore/Inc tools/rle_bench.c Core/Src/rle.c -o /tmp/rle_bench
+ *   /tmp/rle_bench /tmp/scr
+ *
+ * Decodes every 128-byte row of PREFIX.rle, checks it against PREFIX.raw and
+ * reports the decode rate in output bytes per microsecond. The target figure
+ * comes from OLED_BenchDecode() (Debug builds, TRACE_EV_RLE_BENCH).
+ */
+#include "rle.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROW 128
+#define ROUNDS 20000
+
+static uint8_t *load(const char *prefix, const char *ext, long *len) {
+  char path[512];
+  snprintf(path, sizeof(path), "%s.%s", prefix, ext);
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  fseek(f, 0, SEEK_END);
+  *len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t *buf = malloc(*len);
+  if (fread(buf, 1, *len, f) != (size_t)*len) {
+    perror(path);
+    exit(1);
+  }
+  fclose(f);
+  return buf;
+}
+
+static double now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s PREFIX (reads PREFIX.raw and PREFIX.rle)\n",
+            argv[0]);
+    return 2;
+  }
+  long raw_len, rle_len;
+  uint8_t *raw = load(argv[1], "raw", &raw_len);
+  uint8_t *rle = load(argv[1], "rle", &rle_len);
+  long rows = raw_len / ROW;
+  uint8_t out[ROW];
+
+  // verify every row before timing
+  long pos = 0;
+  for (long r = 0; r < rows; r++) {
+    pos += rle_decode(&rle[pos], out, ROW);
+    if (memcmp(out, &raw[r * ROW], ROW) != 0) {
+      fprintf(stderr, "row %ld decodes wrong\n", r);
+      return 1;
+    }
+  }
+  if (pos != rle_len) {
+    fprintf(stderr, "consumed %ld of %ld encoded bytes\n", pos, rle_len);
+    return 1;
+  }
+
+  volatile uint8_t sink = 0;
+  double t0 = now_us();
+  for (int n = 0; n < ROUNDS; n++) {
+    pos = 0;
+    for (long r = 0; r < rows; r++) {
+      pos += rle_decode(&rle[pos], out, ROW);
+      sink ^= out[r & (ROW - 1)];
+    }
+  }
+  double us = now_us() - t0;
+  double bytes = (double)raw_len * ROUNDS;
+
+  printf("%ld rows, %ld bytes raw, %ld bytes RLE (%.1f%%)\n", rows, raw_len,
+         rle_len, 100.0 * rle_len / raw_len);
+  printf("decode: %.1f bytes/us (%.2f us per 1 KB screen)\n", bytes / us,
+         1024.0 * us / bytes);
+  free(raw);
+  free(rle);
+  return 0;
+}
@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+"""Decode the firmware trace stream (USART3, see Core/Inc/trace.h) into a timeline.
+
+Usage:
+    trace_decode.py /dev/ttyUSB0            # read the serial port (460800 8N1)
+    trace_decode.py capture.bin             # decode a raw capture
+    trace_decode.py - < capture.bin         # decode stdin
+
+Frame: 'T' 'R' | count | dropped | count * 16-byte record | BCC
+Record (little endian): cycles u32, id u16, ctx u8, seq u8, arg0 u32, arg1 u32
+BCC is the XOR of every byte from count up to the last record byte.
+Display mirror frames ('OM', tools/oled_mirror.py) on the same port are skipped.
+"""
+
+import argparse
+import os
+import stat
+import struct
+import sys
+import termios
+
+SYNC = b"TR"
+RECORD = struct.Struct("<IHBBII")
+
+# Keep in sync with trace_event_t in Core/Inc/trace.h
+EVENTS = {
+    0x01: "BOOT",
+    0x02: "STOP",
+    0x03: "WAKE",
+    0x04: "KEY",
+    0x05: "UART_RX",
+    0x06: "FAST_PATH",
+    0x07: "UI_STATE",
+    0x08: "SWTIMER",
+    0x09: "OLED_DRAIN",
+    0x0A: "OLED_BENCH",
+    0x0B: "RLE_BENCH",
+    0x0C: "OLED_PM",
+    0x0D: "TEXT_BENCH",
+    0x0E: "I2C_FAULT",
+}
+
+# Cortex-M3 exception numbers (IPSR) for the handlers this firmware uses
+CONTEXTS = {
+    0: "thread",
+    15: "SysTick",
+    16 + 3: "RTC",
+    16 + 6: "EXTI0",
+    16 + 7: "EXTI1",
+    16 + 8: "EXTI2",
+    16 + 9: "EXTI3",
+    16 + 10: "EXTI4",
+    16 + 12: "DMA1_Ch2",
+    16 + 14: "DMA1_Ch4",
+    16 + 15: "DMA1_Ch5",
+    16 + 16: "DMA1_Ch6",
+    16 + 23: "EXTI9_5",
+    16 + 25: "TIM1_UP",
+    16 + 31: "I2C1_EV",
+    16 + 32: "I2C1_ER",
+    16 + 37: "USART1",
+    16 + 39: "USART3",
+    16 + 40: "EXTI15_10",
+    16 + 41: "RTC_Alarm",
+}
+
+KEY_EVENTS = ["PRESS", "RELEASE", "LONG", "REPEAT"]
+UI_STATES = ["BOOT", "MAIN", "ENROLL_SELECT", "DELETE_SELECT", "WAIT_READY",
+             "WAIT_REPLY", "RESULT", "CLOCK"]
+UI_OPS = ["ENROLL", "VERIFY", "DELETE"]
+OLED_PM_STATES = ["ON", "DIM", "OFF"]
+WAKE_SOURCES = [(1, "KEY"), (2, "RTC"), (4, "UART")]
+# HAL_I2C_ERROR_* bits plus OLED_I2C_FAULT_BUSY (Core/Inc/oled_i2c.h)
+I2C_FAULTS = [(0x01, "BERR"), (0x02, "ARLO"), (0x04, "NACK"), (0x08, "OVR"),
+              (0x10, "DMA"), (0x20, "TIMEOUT"), (0x100, "BUSY")]
+
+
+def name_of(table, value):
+    return table[value] if 0 <= value < len(table) else str(value)
+
+
+def describe(event, arg0, arg1):
+    if event == 0x02:
+        return "count=%d" % arg0
+    if event == 0x03:
+        sources = [n for bit, n in WAKE_SOURCES if arg0 & bit] or ["NONE"]
+        return "source=%s clock_us=%d" % ("|".join(sources), arg1)
+    if event == 0x04:
+        return "key=%d %s" % (arg0, name_of(KEY_EVENTS, arg1))
+    if event == 0x05:
+        return "len=%d mid=0x%02X id=0x%02X" % (arg0, arg1 >> 8, arg1 & 0xFF)
+    if event == 0x06:
+        return "user=%d latency_us=%d" % (arg0, arg1)
+    if event == 0x07:
+        return "%s op=%s" % (name_of(UI_STATES, arg0), name_of(UI_OPS, arg1))
+    if event == 0x08:
+        return "cb=0x%08X arg=0x%08X" % (arg0, arg1)
+    if event == 0x09:
+        return "bytes=%d us=%d" % (arg0, arg1)
+    if event == 0x0A:
+        return "per_byte_us=%d stream_us=%d" % (arg0, arg1)
+    if event == 0x0B:
+        return "bytes=%d us=%d (%.1f bytes/us)" % (arg0, arg1, arg0 / max(arg1, 1))
+    if event == 0x0C:
+        return "%s idle_s=%d" % (name_of(OLED_PM_STATES, arg0), arg1)
+    if event == 0x0D:
+        return "width=%d cycles=%d (%.1f cycles/column)" % (arg0, arg1, arg1 / max(arg0, 1))
+    if event == 0x0E:
+        faults = [n for bit, n in I2C_FAULTS if arg0 & bit] or ["0x%X" % arg0]
+        return "fault=%s recoveries=%d" % ("|".join(faults), arg1)
+    return "arg0=0x%08X arg1=0x%08X" % (arg0, arg1)
+
+
+def open_input(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    f = open(path, "rb", buffering=0)
+    if stat.S_ISCHR(os.fstat(f.fileno()).st_mode):
+        speed = getattr(termios, "B%d" % baud)
+        attrs = termios.tcgetattr(f.fileno())
+        attrs[0] = 0                                   # iflag: raw
+        attrs[1] = 0                                   # oflag
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attrs[3] = 0                                   # lflag: no echo/canon
+        attrs[4] = attrs[5] = speed
+        attrs[6][termios.VMIN] = 1
+        attrs[6][termios.VTIME] = 0
+        termios.tcsetattr(f.fileno(), termios.TCSANOW, attrs)
+    return f
+
+
+def frames(stream):
+    """Yield (dropped, [records]) for every frame with a valid BCC."""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            return
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                del buf[:-1]
+                break
+            del buf[:start]
+            if len(buf) < 4:
+                break
+            count = buf[2]
+            size = 4 + count * RECORD.size + 1
+            if count > 16:
+                del buf[:1]
+                continue
+            if len(buf) < size:
+                break
+            bcc = 0
+            for b in buf[2:size - 1]:
+                bcc ^= b
+            if bcc != buf[size - 1]:
+                del buf[:1]  # false sync, rescan from the next byte
+                continue
+            records = [RECORD.unpack_from(buf, 4 + i * RECORD.size)
+                       for i in range(count)]
+            yield buf[3], records
+            del buf[:size]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="serial device, capture file or '-'")
+    parser.add_argument("--baud", type=int, default=460800)
+    parser.add_argument("--mhz", type=float, default=72.0,
+                        help="core clock used by DWT->CYCCNT (default 72)")
+    parser.add_argument("--stall-us", type=float, default=0,
+                        help="flag gaps between records longer than this")
+    args = parser.parse_args()
+
+    stream = open_input(args.input, args.baud)
+    base = None
+    last_cycles = None
+    wraps = 0
+    prev_us = None
+    prev_ctx = 0
+    per_ctx = {}
+
+    print("%14s %12s  %-10s %-10s %s" % ("time_us", "delta_us", "context", "event", "args"))
+    try:
+        for dropped, records in frames(stream):
+            if dropped:
+                print("%14s %12s  %-10s %-10s %d records lost" % ("", "", "", "DROPPED", dropped))
+            for cycles, event, ctx, _seq, arg0, arg1 in records:
+                # CYCCNT wraps every 2^32 cycles (~60 s at 72 MHz) and stops in Stop mode
+                if last_cycles is not None and cycles < last_cycles:
+                    wraps += 1
+                last_cycles = cycles
+                total = (wraps << 32) + cycles
+                if base is None:
+                    base = total
+                now_us = (total - base) / args.mhz
+                delta = 0.0 if prev_us is None else now_us - prev_us
+                ctx_name = CONTEXTS.get(ctx, "IRQ%d" % (ctx - 16))
+                mark = ""
+                if args.stall_us and delta > args.stall_us:
+                    mark = "  <-- stall"
+                elif ctx and prev_ctx and ctx != prev_ctx:
+                    mark = "  <-- after %s" % CONTEXTS.get(prev_ctx, str(prev_ctx))
+                print("%14.1f %12.1f  %-10s %-10s %s%s" % (
+                    now_us, delta, ctx_name, EVENTS.get(event, "0x%04X" % event),
+                    describe(event, arg0, arg1), mark))
+                per_ctx[ctx_name] = per_ctx.get(ctx_name, 0) + 1
+                prev_us = now_us
+                prev_ctx = ctx
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    if per_ctx:
+        print("\nrecords per context: " +
+              ", ".join("%s=%d" % kv for kv in sorted(per_ctx.items())))
+
+
+if __name__ == "__main__":
+    main()
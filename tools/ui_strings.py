@@ -0,0 +1,71 @@
+"""Reader for assets/strings.txt, shared by the OLED asset generators.
+
+Format:
+
+    [ID]            string ID, referenced as STR_ID in C and as ID in screens.txt
+    <lang> <text>   one line per language, e.g. "zh 注册人脸" / "en Enroll face"
+
+Blank lines and lines starting with '#' are ignored. The languages of the first
+entry define the language list; its first language is the default. Every entry
+must give every language exactly once. Text runs to the end of the line with
+surrounding spaces trimmed; wrap it in double quotes to keep them ("" is an
+empty string).
+"""
+
+import re
+import sys
+
+ID = re.compile(r"\[([A-Z][A-Z0-9_]*)\]\s*$")
+LANG = re.compile(r"([a-z]{2})(?:\s(.*))?$")
+
+
+def load_strings(path):
+    """Return (langs, {id: {lang: text}}), ids in file order."""
+    langs = None
+    strings = {}
+    current = None
+    where = path
+
+    def check(entry_id, entry_where):
+        missing = [lang for lang in langs if lang not in strings[entry_id]]
+        if missing:
+            sys.exit("%s: [%s] has no %s text" % (entry_where, entry_id, "/".join(missing)))
+
+    entry_where = None
+    with open(path, encoding="utf-8") as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.rstrip("\n")
+            if not line.strip() or line.lstrip().startswith("#"):
+                continue
+            where = "%s:%d" % (path, lineno)
+            m = ID.match(line.strip())
+            if m:
+                if current is not None:
+                    if langs is None:
+                        langs = list(strings[current])
+                    check(current, entry_where)
+                current = m.group(1)
+                entry_where = where
+                if current in strings:
+                    sys.exit("%s: duplicate ID [%s]" % (where, current))
+                strings[current] = {}
+                continue
+            m = LANG.match(line.strip())
+            if not m or current is None:
+                sys.exit("%s: expected '[ID]' or '<lang> <text>'" % where)
+            lang, text = m.group(1), (m.group(2) or "").strip()
+            if len(text) >= 2 and text[0] == text[-1] == '"':
+                text = text[1:-1]
+            if langs is not None and lang not in langs:
+                sys.exit("%s: language '%s' is not in the first entry" % (where, lang))
+            if lang in strings[current]:
+                sys.exit("%s: [%s] gives '%s' twice" % (where, current, lang))
+            if '"' in text or "\\" in text:
+                sys.exit("%s: quotes and backslashes are not supported" % where)
+            strings[current][lang] = text
+    if current is None:
+        sys.exit("%s: no strings" % path)
+    if langs is None:
+        langs = list(strings[current])
+    check(current, entry_where)
+    return langs, strings